@@ -1,54 +1,158 @@
 #include <bits/stdc++.h>
+#include <charconv>
 
 using namespace std;
 
-string ltrim(const string &);
-string rtrim(const string &);
+// bytes of input parsed at a time, and parsed elements summed at a time
+#define BLOCK_BYTES (1<<24)
+#define BATCH_VALUES 4096
 
+/*
+ * Every element is counted with weight n+1 except the first and the last one, counted with weight n, so the
+ * answer is (n+1)*S - arr[0] - arr[n-1] where S is the plain sum (arr[0] alone for a single element).
+ * Only S, the first and the last element are needed: the elements are summed as they are parsed and never stored.
+ */
+struct PartialSum  {
+    long long count = 0;
+    __int128 sum = 0;
+    int first = 0, last = 0;
+
+    // appends the elements summed in other, which come after these
+    void append(const PartialSum &other)  {
+        if(!other.count)
+            return;
+        if(!count)
+            first = other.first;
+        last = other.last;
+        count += other.count;
+        sum += other.sum;
+    }
+};
 
+bool isBlank(char c)  {
+    return c==' ' || c=='\n' || c=='\r' || c=='\t';
+}
+
+// parses the whitespace separated ints of [begin, end), which must not cut a number in two
+PartialSum sumRange(const char* begin, const char* end)  {
+    PartialSum partial;
+    int batch[BATCH_VALUES];
+    int size = 0;
+    auto flush = [&]()  {
+        // a batch of ints cannot overflow 64 bits, the loop is left to the vectoriser
+        long long batchSum = 0;
+        for(int k = 0; k<size; k++)
+            batchSum += batch[k];
+        partial.sum += batchSum;
+        size = 0;
+    };
+    const char* p = begin;
+    while(true)  {
+        while(p<end && isBlank(*p))
+            p++;
+        if(p>=end)
+            break;
+        int value;
+        from_chars_result parsed = from_chars(p, end, value);
+        if(parsed.ec!=errc())  {
+            // not a number, skipped up to the next blank as getline + stoi would have failed on it anyway
+            while(p<end && !isBlank(*p))
+                p++;
+            continue;
+        }
+        p = parsed.ptr;
+        if(!partial.count)
+            partial.first = value;
+        partial.last = value;
+        partial.count++;
+        batch[size++] = value;
+        if(size==BATCH_VALUES)
+            flush();
+    }
+    flush();
+    return partial;
+}
+
+// sums [begin, end) on up to threads threads, cut at blanks so that no number is split
+PartialSum sumBlock(const char* begin, const char* end, int threads)  {
+    long long bytes = end-begin;
+    threads = max(1, (int)min<long long>(threads, bytes/(1<<16)));
+    vector<const char*> cuts(1, begin);
+    for(int t = 1; t<threads; t++)  {
+        const char* cut = max(cuts.back(), begin+bytes*t/threads);
+        while(cut<end && !isBlank(*cut))
+            cut++;
+        cuts.push_back(cut);
+    }
+    cuts.push_back(end);
+    vector<PartialSum> partials(threads);
+    vector<thread> workers;
+    for(int t = 1; t<threads; t++)
+        workers.push_back(thread([&, t]()  { partials[t] = sumRange(cuts[t], cuts[t+1]); }));
+    partials[0] = sumRange(cuts[0], cuts[1]);
+    for(auto &worker: workers)
+        worker.join();
+    PartialSum total;
+    for(auto &partial: partials)
+        total.append(partial);
+    return total;
+}
 
 /*
  * Complete the 'subarraySum' function below.
  *
  * The function is expected to return a LONG_INTEGER.
- * The function accepts INTEGER_ARRAY arr as parameter.
+ * The array is read from in as the count followed by the elements, one block of BLOCK_BYTES at a time; only the
+ * block being parsed is held in memory whatever the length of the array.
  */
 
-long subarraySum(vector<int> arr) {
-    int n = arr.size();
-    long ans = 0;
-    for(int i = 0; i<n; i++)  {
-        if(i==0 || i==n-1)  {
-            ans+=n*arr[i];
+long subarraySum(FILE* in) {
+    int threads = max(1u, thread::hardware_concurrency());
+    vector<char> buffer(BLOCK_BYTES);
+    PartialSum total;
+    long long count = -1;
+    size_t kept = 0;
+    bool isEnd = false;
+    while(!isEnd)  {
+        size_t length = kept+fread(buffer.data()+kept, 1, buffer.size()-kept, in);
+        isEnd = length<buffer.size();
+        // the number running off the end of the block waits for the next one
+        size_t cut = length;
+        if(!isEnd)
+            while(cut>0 && !isBlank(buffer[cut-1]))
+                cut--;
+        if(cut==0 && !isEnd)  {
+            buffer.resize(2*buffer.size());
+            kept = length;
+            continue;
         }
-        else  {
-            ans+=(n+1)*arr[i];
+        const char* begin = buffer.data(), *end = buffer.data()+cut;
+        // the first number of the input is the count of elements
+        if(count<0)  {
+            while(begin<end && isBlank(*begin))
+                begin++;
+            if(begin<end)
+                begin = from_chars(begin, end, count).ptr;
         }
+        total.append(sumBlock(begin, end, threads));
+        kept = length-cut;
+        memmove(buffer.data(), buffer.data()+cut, kept);
     }
-    return ans;
+    long long n = total.count;
+    if(n==0)
+        return 0;
+    if(n==1)
+        return total.first;
+    // exact in 128 bits, the result is that of summing the weighted elements one by one whenever it fits a long
+    __int128 answer = (__int128)(n+1)*total.sum-total.first-total.last;
+    return (long)answer;
 }
 
 int main()
 {
     ofstream fout(getenv("OUTPUT_PATH"));
 
-    string arr_count_temp;
-    getline(cin, arr_count_temp);
-
-    int arr_count = stoi(ltrim(rtrim(arr_count_temp)));
-
-    vector<int> arr(arr_count);
-
-    for (int i = 0; i < arr_count; i++) {
-        string arr_item_temp;
-        getline(cin, arr_item_temp);
-
-        int arr_item = stoi(ltrim(rtrim(arr_item_temp)));
-
-        arr[i] = arr_item;
-    }
-
-    long result = subarraySum(arr);
+    long result = subarraySum(stdin);
 
     fout << result << "\n";
 
@@ -56,25 +160,3 @@ int main()
 
     return 0;
 }
-
-string ltrim(const string &str) {
-    string s(str);
-
-    s.erase(
-        s.begin(),
-        find_if(s.begin(), s.end(), not1(ptr_fun<int, int>(isspace)))
-    );
-
-    return s;
-}
-
-string rtrim(const string &str) {
-    string s(str);
-
-    s.erase(
-        find_if(s.rbegin(), s.rend(), not1(ptr_fun<int, int>(isspace))).base(),
-        s.end()
-    );
-
-    return s;
-}
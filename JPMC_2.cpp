@@ -7,29 +7,188 @@
 #include <set>
 #include <math.h>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 #define ll long long
 #define inf 1000000000
 #define mod 1000000009
 
-ll factorial(ll n)  {
-    if(n==0)
-        return 1;
+ll power(ll base, ll exponent)  {
     ll res=1;
-    for(ll i = 2; i<=n; i++)
-        res*=i;
+    base%=mod;
+    while(exponent>0)  {
+        if(exponent&1)
+            res=res*base%mod;
+        base=base*base%mod;
+        exponent>>=1;
+    }
     return res;
 }
 
-ll nCr(ll n, ll r)  {
-    if(n<r)
-        return 0;
-    ll res=1;
-    for(ll i = max(r,n-r)+1; i<=n; i++)
-        res*=i;
-    return res/factorial(min(r,n-r));
-}
+/*
+ * Binomial coefficients mod mod (a prime) for millions of queries.
+ * n! and 1/n! are tabulated once up to maxN: the factorials forward, the inverse of the last one by Fermat and
+ * every other inverse backwards from it (1/(i-1)! = i/i!), so building costs O(maxN) plus one exponentiation.
+ * A query is then nCr = n! * 1/r! * 1/(n-r)!, two multiplications.
+ * The tables can be kept in a cache file, mapped back into memory by the next run instead of being computed again.
+ * For n >= mod Lucas' theorem splits n and r into base mod digits, and a digit over maxN (which the tables cannot
+ * reach below mod) is multiplied out directly in O(min(r,n-r)).
+ */
+class BinomialTable  {
+private:
+    struct CacheHeader  {
+        char magic[8];      // "NCRTABLE"
+        uint64_t modulus;
+        uint64_t size;      // entries of each table
+    };
+    ll maxN;
+    const uint32_t* fact;
+    const uint32_t* invFact;
+    vector<uint32_t> factStore, invFactStore;
+    void* mapping=NULL;
+    size_t mappingSize=0;
+
+    bool mapCache(const char* cacheFile)  {
+        int fd=open(cacheFile, O_RDONLY);
+        if(fd<0)
+            return false;
+        struct stat status;
+        bool isMapped=false;
+        if(fstat(fd, &status)==0 && (size_t)status.st_size>=sizeof(CacheHeader))  {
+            void* data=mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data!=MAP_FAILED)  {
+                const CacheHeader* header=(const CacheHeader*)data;
+                size_t expected=sizeof(CacheHeader)+2*header->size*sizeof(uint32_t);
+                if(!memcmp(header->magic, "NCRTABLE", 8) && header->modulus==mod && header->size>=(uint64_t)maxN+1 && (size_t)status.st_size==expected)  {
+                    mapping=data;
+                    mappingSize=status.st_size;
+                    fact=(const uint32_t*)(header+1);
+                    invFact=fact+header->size;
+                    isMapped=true;
+                }
+                else
+                    munmap(data, status.st_size);
+            }
+        }
+        close(fd);
+        return isMapped;
+    }
+
+    void build()  {
+        factStore.resize(maxN+1);
+        invFactStore.resize(maxN+1);
+        factStore[0]=1;
+        for(ll i = 1; i<=maxN; i++)
+            factStore[i]=factStore[i-1]*(uint64_t)i%mod;
+        invFactStore[maxN]=power(factStore[maxN], mod-2);
+        for(ll i = maxN; i>0; i--)
+            invFactStore[i-1]=invFactStore[i]*(uint64_t)i%mod;
+        fact=factStore.data();
+        invFact=invFactStore.data();
+    }
+
+    void writeCache(const char* cacheFile)  {
+        FILE* out=fopen(cacheFile, "wb");
+        if(!out)
+            return;
+        CacheHeader header;
+        memcpy(header.magic, "NCRTABLE", 8);
+        header.modulus=mod;
+        header.size=maxN+1;
+        bool isWritten=fwrite(&header, sizeof(header), 1, out)==1
+                       && fwrite(fact, sizeof(uint32_t), maxN+1, out)==(size_t)maxN+1
+                       && fwrite(invFact, sizeof(uint32_t), maxN+1, out)==(size_t)maxN+1;
+        isWritten=fclose(out)==0 && isWritten;
+        //a half written cache would only be rejected by the next run, it is not left behind
+        if(!isWritten)
+            remove(cacheFile);
+    }
+
+    //nCr for n < mod and n beyond the tables, multiplying out the smaller side
+    ll direct(ll n, ll r)  {
+        r=min(r, n-r);
+        ll numerator=1, denominator=1;
+        for(ll i = 0; i<r; i++)  {
+            numerator=numerator*((n-i)%mod)%mod;
+            denominator=denominator*((i+1)%mod)%mod;
+        }
+        return numerator*power(denominator, mod-2)%mod;
+    }
+
+    //nCr for 0 <= r <= n < mod
+    ll small(ll n, ll r)  {
+        if(n<=maxN)
+            return (uint64_t)fact[n]*invFact[r]%mod*invFact[n-r]%mod;
+        return direct(n, r);
+    }
+
+public:
+    /*
+     * maxN     largest n answered from the tables in O(1), at most mod-1
+     * cacheFile   tables are mapped from this file if it holds at least maxN+1 entries for mod, else built and written to it
+     */
+    BinomialTable(ll maxN, const char* cacheFile=NULL)  {
+        this->maxN=max(0LL, min(maxN, (ll)mod-1));
+        if(cacheFile && mapCache(cacheFile))
+            return;
+        build();
+        if(cacheFile)
+            writeCache(cacheFile);
+    }
+
+    BinomialTable(const BinomialTable&)=delete;
+    BinomialTable& operator=(const BinomialTable&)=delete;
+
+    ~BinomialTable()  {
+        if(mapping)
+            munmap(mapping, mappingSize);
+    }
+
+    ll factorial(ll n)  {
+        if(n>=mod)
+            return 0;
+        if(n<=maxN)
+            return fact[n];
+        ll res=fact[maxN];
+        for(ll i = maxN+1; i<=n; i++)
+            res=res*i%mod;
+        return res;
+    }
+
+    ll nCr(ll n, ll r)  {
+        if(r<0 || n<r)
+            return 0;
+        if(n<mod)
+            return small(n, r);
+        //Lucas: the product of the binomials of the base mod digits, 0 as soon as a digit of r exceeds that of n
+        ll res=1;
+        while(n>0 && res)  {
+            ll digitN=n%mod, digitR=r%mod;
+            if(digitR>digitN)
+                return 0;
+            res=res*small(digitN, digitR)%mod;
+            n/=mod;
+            r/=mod;
+        }
+        return res;
+    }
+
+    //out[i] = nCr(n[i], r[i]) for i < count
+    void nCr(const ll* n, const ll* r, ll* out, size_t count)  {
+        for(size_t i = 0; i<count; i++)  {
+            if(r[i]>=0 && r[i]<=n[i] && n[i]<=maxN)
+                out[i]=(uint64_t)fact[n[i]]*invFact[r[i]]%mod*invFact[n[i]-r[i]]%mod;
+            else
+                out[i]=nCr(n[i], r[i]);
+        }
+    }
+};
 
 int main() {
     ios_base::sync_with_stdio(0);
@@ -44,4 +203,4 @@ int main() {
         //print output
     }
     return 0;
-  }
\ No newline at end of file
+  }
@@ -31,7 +31,7 @@ class Vertex  {
 private:
     string id;
     pair<T,T> coordinate;
-    Edge<T>* incidentEdge;
+    Edge<T>* incidentEdge = NULL;
 
 public:
     //constructors
@@ -137,11 +137,11 @@ public:
 template <class T>
 class Edge  {
 private:
-    Vertex<T>* originVertex;
-    Face<T>* leftFace;
-    Edge<T>* twinEdge;
-    Edge<T>* nextEdge;
-    Edge<T>* prevEdge;
+    Vertex<T>* originVertex = NULL;
+    Face<T>* leftFace = NULL;
+    Edge<T>* twinEdge = NULL;
+    Edge<T>* nextEdge = NULL;
+    Edge<T>* prevEdge = NULL;
 
 public:
     //constructors
@@ -260,8 +260,8 @@ public:
 template <class T>
 class Face  {
 private:
-    int id;
-    Edge<T>* incidentEdge;
+    int id = 0;
+    Edge<T>* incidentEdge = NULL;
 
 public:
     //constructors
@@ -0,0 +1,139 @@
+/*
+Header File boundedQueue.h
+usage- #include "boundedQueue.h"
+
+Fixed capacity lock-free queue connecting the stages of the streamed decomposition (reader, workers, writer).
+Any number of threads may push and pop; a push into a full queue waits, which is what keeps a fast reader from
+running ahead of slow workers or a slow output disk.
+The slots carry sequence numbers (the bounded MPMC queue of D. Vyukov), so neither side ever takes a lock.
+*/
+
+/**
+
+*@file boundedQueue.h
+*@brief Bounded lock-free multi-producer multi-consumer queue with blocking push and pop.
+
+*/
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+/**
+ * @brief Waits a little longer on every call, yielding first and then sleeping up to a millisecond
+ * @param attempt number of times the caller already waited, updated
+ */
+inline void queueBackoff(int &attempt)  {
+    if(attempt<64)
+        this_thread::yield();
+    else
+        this_thread::sleep_for(chrono::microseconds(min(1000, 10*(attempt-63))));
+    attempt++;
+}
+
+/**
+ * @class BoundedQueue
+ * @brief Lock-free queue of at most capacity items
+ * @tparam I item type, moved in and out
+ */
+template <class I>
+class BoundedQueue  {
+private:
+    struct Slot  {
+        atomic<size_t> sequence;
+        I item;
+    };
+    unique_ptr<Slot[]> slots;
+    size_t mask;
+    //the two ends on their own cache lines, producers and consumers do not share one
+    alignas(64) atomic<size_t> pushPosition;
+    alignas(64) atomic<size_t> popPosition;
+
+public:
+    /**
+     * @brief Creates an empty queue
+     * @param capacity rounded up to a power of two
+     */
+    BoundedQueue(size_t capacity)  {
+        size_t size = 2;
+        while(size<capacity)
+            size *= 2;
+        slots.reset(new Slot[size]);
+        mask = size-1;
+        for(size_t i = 0; i<size; i++)
+            slots[i].sequence.store(i, memory_order_relaxed);
+        pushPosition.store(0, memory_order_relaxed);
+        popPosition.store(0, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds an item if there is room
+     * @return false if the queue is full, the item is left untouched then
+     */
+    bool tryPush(I &item)  {
+        size_t position = pushPosition.load(memory_order_relaxed);
+        Slot* slot;
+        while(true)  {
+            slot = &slots[position&mask];
+            size_t sequence = slot->sequence.load(memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence-(intptr_t)position;
+            if(difference==0)  {
+                if(pushPosition.compare_exchange_weak(position, position+1, memory_order_relaxed))
+                    break;
+            }
+            else if(difference<0)
+                return false;
+            else
+                position = pushPosition.load(memory_order_relaxed);
+        }
+        slot->item = move(item);
+        slot->sequence.store(position+1, memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Takes the oldest item if there is one
+     * @return false if the queue is empty
+     */
+    bool tryPop(I &item)  {
+        size_t position = popPosition.load(memory_order_relaxed);
+        Slot* slot;
+        while(true)  {
+            slot = &slots[position&mask];
+            size_t sequence = slot->sequence.load(memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence-(intptr_t)(position+1);
+            if(difference==0)  {
+                if(popPosition.compare_exchange_weak(position, position+1, memory_order_relaxed))
+                    break;
+            }
+            else if(difference<0)
+                return false;
+            else
+                position = popPosition.load(memory_order_relaxed);
+        }
+        item = move(slot->item);
+        slot->sequence.store(position+mask+1, memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Adds an item, waiting while the queue is full
+     */
+    void push(I item)  {
+        int attempt = 0;
+        while(!tryPush(item))
+            queueBackoff(attempt);
+    }
+
+    /**
+     * @brief Takes the oldest item, waiting while the queue is empty
+     */
+    I pop()  {
+        I item;
+        int attempt = 0;
+        while(!tryPop(item))
+            queueBackoff(attempt);
+        return item;
+    }
+};
+
+#endif
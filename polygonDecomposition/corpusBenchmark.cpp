@@ -0,0 +1,350 @@
+/**
+ * @file corpusBenchmark.cpp
+ * @brief End-to-end benchmark of the decomposition over generated polygon families.
+ *
+ * usage- ./corpusBenchmark [options]
+ *     --sizes 10,100,1000       sizes to generate (default 10,100,1000,10000,100000,1000000)
+ *     --families star,comb      families to run (default all, see polygonFamilies())
+ *     --seeds 3                 instances per family and size (default 1)
+ *     --timeout 60              seconds allowed per instance, larger sizes of a family are skipped after a timeout
+ *     --results file.csv        where the results go (default ../Outputs/corpusResults.csv)
+ *     --baseline file.csv       earlier results to compare against, exits with 1 on a regression
+ *     --tolerance 0.25          allowed relative slowdown before a time regression is flagged
+ *     --corpus dir              also write every generated polygon in input_format.txt layout to dir
+ *     --tvsn file               also write "n time" lines for timeGraph.py
+ *
+ * Every instance runs in its own child process, so its peak resident memory can be read back with wait4
+ * and a crash or timeout only costs that instance. Before an instance is recorded as ok its decomposition is
+ * checked (convex faces, face areas adding up to the polygon, twins linking back); one that fails is recorded as
+ * invalid, which counts as a regression against an ok baseline.
+ */
+
+#define POLYGON_DECOMPOSITION_LIBRARY
+#include "polygonDecomposition_final.cpp"
+#include "polygonGenerator.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * @struct BenchmarkResult
+ * @brief One row of the results file
+ */
+struct BenchmarkResult  {
+    string family;
+    int n = 0;
+    unsigned seed = 0;
+    string status;
+    long long pieces = 0;
+    long long notches = 0;
+    long long microseconds = 0;
+    long long peakKilobytes = 0;
+};
+
+/**
+ * @brief What the child process reports back through the pipe
+ */
+struct ChildReport  {
+    long long pieces;
+    long long notches;
+    long long microseconds;
+    //first problem the validation found, empty if the decomposition is valid
+    char problem[96];
+};
+
+/**
+ * @brief Twice the signed area of a ring of points, negative for a clockwise ring
+ * @brief O(k) time where k is the number of points
+ */
+double doubleArea(vector<pair<T,T>> &ring)  {
+    double area = 0;
+    for(int i = 0; i<ring.size(); i++)  {
+        pair<T,T> a = ring[i], b = ring[(i+1)%ring.size()];
+        area += (double)a.first*b.second-(double)b.first*a.second;
+    }
+    return area;
+}
+
+/**
+ * @brief Validates a decomposition of a polygon- every face convex and clockwise, the face areas adding up to the
+ * area of the polygon and every twin edge having the edge as its twin and running the other way
+ * @brief O(n) time where n is the size of the decomposition
+ * @param decomposition decomposition to check
+ * @param vertices vertices of the polygon in clockwise order
+ * @return description of the first problem found, empty if there is none
+ */
+string validateDecomposition(DCEL<T>* decomposition, vector<Vertex<T>*> &vertices)  {
+    double faceArea = 0;
+    for(auto face: decomposition->getFaces())  {
+        vector<Vertex<T>*> corners;
+        Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            corners.push_back(edge->getOriginVertex());
+            Edge<T>* twin = edge->getTwinEdge();
+            if(twin && (twin->getTwinEdge()!=edge || twin->getOriginVertex()!=edge->getNextEdge()->getOriginVertex()))
+                return "twin of an edge of face "+to_string(face->getId())+" does not link back";
+            edge=edge->getNextEdge();
+        }while(edge!=fixEdge);
+        int k = corners.size();
+        for(int i = 0; i<k; i++)
+            if(isReflex(corners[(i-1+k)%k], corners[i], corners[(i+1)%k]))
+                return "face "+to_string(face->getId())+" is not convex at "+corners[i]->getId();
+        vector<pair<T,T>> ring;
+        for(auto corner: corners)
+            ring.push_back(corner->getCoordinate());
+        faceArea += doubleArea(ring);
+    }
+    vector<pair<T,T>> ring;
+    for(auto vertex: vertices)
+        ring.push_back(vertex->getCoordinate());
+    double polygonArea = doubleArea(ring);
+    //the coordinates are floats, the areas are summed in double
+    if(fabs(faceArea-polygonArea)>1e-6*fabs(polygonArea))
+        return "face areas add up to "+to_string(-faceArea/2)+" instead of "+to_string(-polygonArea/2);
+    return "";
+}
+
+/**
+ * @brief Decomposes one polygon in the current process and validates the result
+ * @return the piece and notch counts, the time spent in decomposePolygon and the problem found by validateDecomposition
+ */
+ChildReport runInstance(GeneratedPolygon &ring)  {
+    vector<Vertex<T>*> vertices;
+    vector<Edge<T>*> edges;
+    for(int i = 0; i<ring.size(); i++)
+        appendPolygonVertex(vertices, edges, "v"+to_string(i), {(T)ring[i].first, (T)ring[i].second});
+
+    ChildReport report = {0, 0, 0, ""};
+    int n = vertices.size();
+    for(int i = 0; i<n; i++)
+        if(isReflex(vertices[(i-1+n)%n], vertices[i], vertices[(i+1)%n]))
+            report.notches++;
+
+    auto start = chrono::steady_clock::now();
+    DCEL<T>* decomposition = decomposePolygon(vertices, edges);
+    auto stop = chrono::steady_clock::now();
+    report.microseconds = chrono::duration_cast<chrono::microseconds>(stop-start).count();
+    report.pieces = decomposition->getFaces().size();
+    string problem = validateDecomposition(decomposition, vertices);
+    snprintf(report.problem, sizeof(report.problem), "%s", problem.c_str());
+    return report;
+}
+
+/**
+ * @brief Runs one instance in a child process with a time limit
+ * @brief fills status with ok, invalid, timeout or crashed
+ */
+void runIsolated(GeneratedPolygon &ring, int timeout, BenchmarkResult &result)  {
+    int channel[2];
+    if(pipe(channel)!=0)  {
+        result.status = "crashed";
+        return;
+    }
+    fflush(stdout);
+    pid_t child = fork();
+    if(child==0)  {
+        close(channel[0]);
+        alarm(timeout);
+        ChildReport report = runInstance(ring);
+        ssize_t written = write(channel[1], &report, sizeof(report));
+        _exit(written==sizeof(report) ? 0 : 1);
+    }
+    close(channel[1]);
+    ChildReport report;
+    ssize_t received = read(channel[0], &report, sizeof(report));
+    close(channel[0]);
+
+    int status;
+    struct rusage usage;
+    wait4(child, &status, 0, &usage);
+    result.peakKilobytes = usage.ru_maxrss;
+    if(received==sizeof(report) && WIFEXITED(status) && WEXITSTATUS(status)==0)  {
+        result.status = report.problem[0] ? "invalid" : "ok";
+        if(report.problem[0])
+            cerr<<result.family<<" "<<result.n<<" seed "<<result.seed<<": "<<report.problem<<"\n";
+        result.pieces = report.pieces;
+        result.notches = report.notches;
+        result.microseconds = report.microseconds;
+    }
+    else if(WIFSIGNALED(status) && WTERMSIG(status)==SIGALRM)  {
+        result.status = "timeout";
+        result.microseconds = timeout*1000000LL;
+    }
+    else
+        result.status = "crashed";
+}
+
+/**
+ * @brief Splits a comma separated list
+ */
+vector<string> splitList(string list)  {
+    vector<string> items;
+    stringstream stream(list);
+    string item;
+    while(getline(stream, item, ','))
+        if(!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+/**
+ * @brief Writes a generated polygon in input_format.txt layout
+ */
+void writeCorpusFile(string fileName, GeneratedPolygon &ring)  {
+    ofstream out(fileName);
+    out<<ring.size()<<"\n"<<fixed<<setprecision(0);
+    for(int i = 0; i<ring.size(); i++)
+        out<<"v"<<i<<" "<<ring[i].first<<" "<<ring[i].second<<"\n";
+}
+
+/**
+ * @brief Header line of the results file
+ */
+const string resultsHeader = "family,n,seed,status,pieces,notches,microseconds,peak_kb";
+
+/**
+ * @brief Reads a results file written by an earlier run
+ */
+map<tuple<string,int,unsigned>, BenchmarkResult> readResults(string fileName)  {
+    map<tuple<string,int,unsigned>, BenchmarkResult> results;
+    ifstream in(fileName);
+    string line;
+    getline(in, line);
+    while(getline(in, line))  {
+        vector<string> fields = splitList(line);
+        if(fields.size()<8)
+            continue;
+        BenchmarkResult result;
+        result.family = fields[0];
+        result.n = stoi(fields[1]);
+        result.seed = stoul(fields[2]);
+        result.status = fields[3];
+        result.pieces = stoll(fields[4]);
+        result.notches = stoll(fields[5]);
+        result.microseconds = stoll(fields[6]);
+        result.peakKilobytes = stoll(fields[7]);
+        results[{result.family, result.n, result.seed}] = result;
+    }
+    return results;
+}
+
+/**
+ * @brief Compares a result with its baseline
+ * @return a description of the regression, empty if there is none
+ */
+string findRegression(BenchmarkResult &result, BenchmarkResult &baseline, double tolerance)  {
+    if(baseline.status!="ok")
+        return "";
+    if(result.status!="ok")
+        return result.status+" (baseline ok)";
+    if(result.pieces>baseline.pieces)
+        return "pieces "+to_string(baseline.pieces)+" -> "+to_string(result.pieces);
+    //differences under a millisecond are noise
+    if(result.microseconds>baseline.microseconds*(1+tolerance) && result.microseconds-baseline.microseconds>1000)
+        return "time "+to_string(baseline.microseconds)+"us -> "+to_string(result.microseconds)+"us";
+    if(result.peakKilobytes>baseline.peakKilobytes*(1+tolerance) && result.peakKilobytes-baseline.peakKilobytes>4096)
+        return "memory "+to_string(baseline.peakKilobytes)+"KB -> "+to_string(result.peakKilobytes)+"KB";
+    return "";
+}
+
+int main(int argc, char* argv[])  {
+    vector<string> sizes = {"10", "100", "1000", "10000", "100000", "1000000"};
+    vector<string> families = polygonFamilies();
+    int seeds = 1, timeout = 60;
+    double tolerance = 0.25;
+    string resultsFile = "../Outputs/corpusResults.csv", baselineFile, corpusDirectory, tvsnFile;
+
+    for(int i = 1; i<argc; i++)  {
+        string argument = argv[i];
+        bool hasValue = i+1<argc;
+        if(argument=="--sizes" && hasValue)
+            sizes = splitList(argv[++i]);
+        else if(argument=="--families" && hasValue)
+            families = splitList(argv[++i]);
+        else if(argument=="--seeds" && hasValue)
+            seeds = atoi(argv[++i]);
+        else if(argument=="--timeout" && hasValue)
+            timeout = atoi(argv[++i]);
+        else if(argument=="--results" && hasValue)
+            resultsFile = argv[++i];
+        else if(argument=="--baseline" && hasValue)
+            baselineFile = argv[++i];
+        else if(argument=="--tolerance" && hasValue)
+            tolerance = atof(argv[++i]);
+        else if(argument=="--corpus" && hasValue)
+            corpusDirectory = argv[++i];
+        else if(argument=="--tvsn" && hasValue)
+            tvsnFile = argv[++i];
+        else  {
+            cerr<<"Unknown option "<<argument<<"\n";
+            return 2;
+        }
+    }
+    //the benchmark times the decomposition, not the step by step trace
+    printSteps = false;
+
+    map<tuple<string,int,unsigned>, BenchmarkResult> baseline;
+    if(!baselineFile.empty())
+        baseline = readResults(baselineFile);
+
+    ofstream results(resultsFile);
+    if(!results)  {
+        cerr<<"Could not open "<<resultsFile<<"\n";
+        return 2;
+    }
+    results<<resultsHeader<<"\n";
+    ofstream tvsn;
+    if(!tvsnFile.empty())
+        tvsn.open(tvsnFile);
+
+    int regressions = 0;
+    for(auto family: families)  {
+        bool isOverBudget = false;
+        for(auto size: sizes)  {
+            int n = stoi(size);
+            for(unsigned seed = 1; seed<=seeds; seed++)  {
+                BenchmarkResult result;
+                result.family = family;
+                result.n = n;
+                result.seed = seed;
+                GeneratedPolygon ring = generatePolygon(family, n, seed);
+                if(ring.empty())  {
+                    cerr<<"Unknown family "<<family<<"\n";
+                    return 2;
+                }
+                if(!corpusDirectory.empty())
+                    writeCorpusFile(corpusDirectory+"/"+family+"_"+size+"_"+to_string(seed)+".txt", ring);
+
+                if(isOverBudget)
+                    result.status = "skipped";
+                else
+                    runIsolated(ring, timeout, result);
+                if(result.status=="timeout")
+                    isOverBudget = true;
+
+                results<<result.family<<","<<result.n<<","<<result.seed<<","<<result.status<<","<<result.pieces<<","
+                       <<result.notches<<","<<result.microseconds<<","<<result.peakKilobytes<<"\n";
+                results.flush();
+                if(tvsn.is_open() && result.status=="ok")
+                    tvsn<<ring.size()<<"\t"<<result.microseconds<<"\n";
+
+                cout<<left<<setw(12)<<family<<setw(9)<<n<<"seed "<<setw(3)<<seed<<setw(8)<<result.status;
+                if(result.status=="ok")
+                    cout<<result.pieces<<" pieces, "<<result.notches<<" notches, "<<result.microseconds<<" us, "<<result.peakKilobytes<<" KB";
+                auto it = baseline.find({family, n, seed});
+                if(it!=baseline.end())  {
+                    string regression = findRegression(result, it->second, tolerance);
+                    if(!regression.empty())  {
+                        cout<<"  REGRESSION: "<<regression;
+                        regressions++;
+                    }
+                }
+                cout<<"\n";
+            }
+        }
+    }
+    if(!baselineFile.empty())
+        cout<<regressions<<" regressions against "<<baselineFile<<"\n";
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file decompositionBinary.h
+ * @brief Layout of the columnar binary decomposition file (.pdcl) and a zero-copy view over it.
+ *
+ * The file is meant to be mapped into memory (mmap/MapViewOfFile) and used in place, every section
+ * starts on an 8 byte boundary and is addressed by an absolute offset stored in the header.
+ *
+ * Sections, in file order:
+ *  - vertex table   : vertexCount pairs of (x,y), each coordinate coordinateSize bytes wide
+ *  - face offsets   : faceCount+1 uint32, face f uses vertexIndices[faceOffsets[f] .. faceOffsets[f+1])
+ *  - vertex indices : indexCount uint32 into the vertex table, faces listed clockwise
+ *  - twins          : (optional) indexCount int32, position in vertexIndices of the twin half edge, -1 on the boundary
+ *  - id offsets     : (optional) vertexCount+1 uint32 into the id characters
+ *  - id characters  : (optional) idBytes chars, original vertex ids without terminators
+ *
+ * Half edge k of a face goes from vertexIndices[k] to the next index of the same face (cyclically).
+ * All integers are stored in the byte order of the machine that wrote the file.
+ *
+ * The face record file (.pfr) trades the shared vertex table for fixed size faces: a 64 byte FaceRecordHeader
+ * followed by recordCount FaceRecords of 64 bytes, one face each, so every face is one cache line of a mapped
+ * file and a kernel walks them without indirection. It needs faces of at most FACE_RECORD_VERTICES vertices.
+ */
+
+#ifndef DECOMPOSITION_BINARY_H
+#define DECOMPOSITION_BINARY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @brief Flag set when the twin section is present
+ */
+#define PDCL_HAS_TWINS 1u
+
+/**
+ * @brief Flag set when the vertex id sections are present
+ */
+#define PDCL_HAS_IDS 2u
+
+/**
+ * @brief Current version of the layout
+ */
+#define PDCL_VERSION 1u
+
+/**
+ * @struct DecompositionBinaryHeader
+ * @brief Fixed size header at offset 0 of a .pdcl file
+ */
+struct DecompositionBinaryHeader  {
+    char magic[4];              ///< "PDCL"
+    uint32_t version;           ///< PDCL_VERSION
+    uint32_t flags;             ///< combination of PDCL_HAS_TWINS and PDCL_HAS_IDS
+    uint32_t coordinateSize;    ///< sizeof the coordinate type (4 for float, 8 for double)
+    uint32_t vertexCount;
+    uint32_t faceCount;
+    uint32_t indexCount;
+    uint32_t idBytes;
+    uint64_t vertexTableOffset;
+    uint64_t faceOffsetsOffset;
+    uint64_t vertexIndicesOffset;
+    uint64_t twinsOffset;       ///< 0 if there are no twins
+    uint64_t idOffsetsOffset;   ///< 0 if there are no ids
+    uint64_t idCharsOffset;     ///< 0 if there are no ids
+};
+
+/**
+ * @brief Most vertices of a face record, 7 float pairs next to the count and the face id fill 64 bytes
+ */
+#define FACE_RECORD_VERTICES 7
+
+/**
+ * @brief Current version of the face record layout
+ */
+#define PFR_VERSION 1u
+
+/**
+ * @struct FaceRecordHeader
+ * @brief Fixed size header at offset 0 of a .pfr file, as long as a record so the records stay aligned
+ */
+struct alignas(64) FaceRecordHeader  {
+    char magic[4];              ///< "PFCR"
+    uint32_t version;           ///< PFR_VERSION
+    uint32_t recordCount;
+    uint32_t maxVertices;       ///< most vertices of any record
+    char reserved[48];
+};
+
+/**
+ * @struct FaceRecord
+ * @brief One convex face in one cache line, coordinates split into x and y for SIMD loads
+ *
+ * Vertices 0 .. count-1 are the face clockwise; the slots after them repeat vertex 0, so a kernel running over all
+ * FACE_RECORD_VERTICES edges only adds edges of length zero.
+ */
+struct alignas(64) FaceRecord  {
+    uint32_t count;
+    float x[FACE_RECORD_VERTICES];
+    float y[FACE_RECORD_VERTICES];
+    int32_t id;                 ///< id of the face in the decomposition
+};
+
+static_assert(sizeof(FaceRecordHeader)==64 && sizeof(FaceRecord)==64, "face records are one cache line each");
+
+/**
+ * @brief Rounds a file offset up to the 8 byte alignment used by every section
+ */
+inline uint64_t pdclAlign(uint64_t offset)  {
+    return (offset+7)&~(uint64_t)7;
+}
+
+/**
+ * @class DecompositionBinaryView
+ * @brief Read only view over a .pdcl buffer, no data is copied or parsed
+ * @tparam C coordinate type the file was written with
+ *
+ * Usage-
+ *     void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+ *     DecompositionBinaryView<float> view;
+ *     if(view.open(data, size)) ...
+ */
+template <class C>
+class DecompositionBinaryView  {
+private:
+    const unsigned char* base = NULL;
+    const DecompositionBinaryHeader* header = NULL;
+
+public:
+    /**
+     * @brief Attaches the view to a buffer holding a complete file
+     * @return false if the buffer is not a valid .pdcl file for the coordinate type C
+     */
+    bool open(const void* data, size_t size)  {
+        if(size<sizeof(DecompositionBinaryHeader))
+            return false;
+        const DecompositionBinaryHeader* h = (const DecompositionBinaryHeader*)data;
+        if(memcmp(h->magic, "PDCL", 4)!=0 || h->version!=PDCL_VERSION || h->coordinateSize!=sizeof(C))
+            return false;
+        if(h->vertexIndicesOffset+(uint64_t)h->indexCount*sizeof(uint32_t)>size)
+            return false;
+        if((h->flags&PDCL_HAS_TWINS) && h->twinsOffset+(uint64_t)h->indexCount*sizeof(int32_t)>size)
+            return false;
+        if((h->flags&PDCL_HAS_IDS) && h->idCharsOffset+h->idBytes>size)
+            return false;
+        this->base = (const unsigned char*)data;
+        this->header = h;
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of distinct vertices
+     */
+    uint32_t vertexCount() const  {
+        return header->vertexCount;
+    }
+
+    /**
+     * @brief Returns the number of convex faces
+     */
+    uint32_t faceCount() const  {
+        return header->faceCount;
+    }
+
+    /**
+     * @brief Returns the coordinates as x0,y0,x1,y1,...
+     */
+    const C* coordinates() const  {
+        return (const C*)(base+header->vertexTableOffset);
+    }
+
+    /**
+     * @brief Returns the faceCount+1 face offsets
+     */
+    const uint32_t* faceOffsets() const  {
+        return (const uint32_t*)(base+header->faceOffsetsOffset);
+    }
+
+    /**
+     * @brief Returns the flat vertex index array
+     */
+    const uint32_t* vertexIndices() const  {
+        return (const uint32_t*)(base+header->vertexIndicesOffset);
+    }
+
+    /**
+     * @brief Returns the twin array, NULL if it was not written
+     */
+    const int32_t* twins() const  {
+        if(!(header->flags&PDCL_HAS_TWINS))
+            return NULL;
+        return (const int32_t*)(base+header->twinsOffset);
+    }
+
+    /**
+     * @brief Returns the id of vertex i and its length through length, NULL if ids were not written
+     */
+    const char* vertexId(uint32_t i, uint32_t &length) const  {
+        if(!(header->flags&PDCL_HAS_IDS))
+            return NULL;
+        const uint32_t* offsets = (const uint32_t*)(base+header->idOffsetsOffset);
+        length = offsets[i+1]-offsets[i];
+        return (const char*)(base+header->idCharsOffset+offsets[i]);
+    }
+};
+
+#endif
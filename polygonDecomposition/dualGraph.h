@@ -0,0 +1,165 @@
+/*
+Header File dualGraph.h
+usage- #include "dualGraph.h" (after dcel.h)
+
+Face adjacency of a finished decomposition, which convex faces share an edge and along which segment.
+It is read off the twin links in one pass over the half edges instead of matching faces geometrically, and kept in
+compressed sparse row form: the neighbours of face f are neighbours[offsets[f] .. offsets[f+1]), in the clockwise
+order of the face, and entry k crosses the portal from portalFrom[k] to portalTo[k], walked clockwise around face f
+(so the neighbour lists the same portal the other way round). Half edges a face shares with the same neighbour one
+after another (a straight angle on the shared side) make up one portal.
+*/
+
+/**
+
+*@file dualGraph.h
+*@brief Dual graph of a decomposition in compressed sparse row form, with the portal segment of every adjacency.
+
+*/
+
+#ifndef DUAL_GRAPH_H
+#define DUAL_GRAPH_H
+
+/**
+ * @class DualGraph
+ * @brief Face adjacency and shared portals of the faces of a decomposition
+ * @tparam C coordinate type of the DCEL
+ *
+ * Usage-
+ *     DualGraph<float> dual(decomposition);
+ *     for(int k = dual.begin(f); k<dual.end(f); k++)
+ *         dual.getNeighbour(k), dual.getPortalFrom(k), dual.getPortalTo(k);   // faces are indices into getFaces()
+ */
+template <class C>
+class DualGraph  {
+private:
+    vector<int> faceIds;
+    vector<int> offsets;
+    vector<int> neighbours;
+    vector<pair<C,C>> portalFrom, portalTo;
+
+public:
+    /**
+     * @brief Builds the dual graph of a decomposition
+     * @brief O(E) expected time and O(E) space where E is the number of half edges of the decomposition
+     */
+    DualGraph(DCEL<C>* decomposition)  {
+        vector<Face<C>*> faces = decomposition->getFaces();
+        //the face of every half edge, from the face cycles as not every engine sets the left faces
+        unordered_map<Edge<C>*, int> faceOf;
+        for(int f = 0; f<faces.size(); f++)  {
+            faceIds.push_back(faces[f]->getId());
+            Edge<C>* edge=faces[f]->getIncidentEdge(), *fixEdge = faces[f]->getIncidentEdge();
+            do  {
+                faceOf[edge] = f;
+                edge=edge->getNextEdge();
+            }while(edge!=fixEdge);
+        }
+
+        offsets.push_back(0);
+        vector<pair<Edge<C>*,int>> sides;
+        for(int f = 0; f<faces.size(); f++)  {
+            //every half edge of the face with the face across it, -1 on the boundary
+            sides.clear();
+            Edge<C>* edge=faces[f]->getIncidentEdge(), *fixEdge = faces[f]->getIncidentEdge();
+            do  {
+                Edge<C>* twin = edge->getTwinEdge();
+                auto across = twin ? faceOf.find(twin) : faceOf.end();
+                sides.push_back({edge, across==faceOf.end() || across->second==f ? -1 : across->second});
+                edge=edge->getNextEdge();
+            }while(edge!=fixEdge);
+            int k = sides.size(), first = 0;
+            //start where the face across changes, so that a portal is not cut in two where the cycle closes
+            while(first<k && sides[first].second==sides[(first+k-1)%k].second)
+                first++;
+            if(first==k)
+                first = 0;
+            for(int i = 0; i<k; i++)  {
+                pair<Edge<C>*,int> &side = sides[(first+i)%k];
+                if(side.second<0)
+                    continue;
+                pair<C,C> to = side.first->getNextEdge()->getOriginVertex()->getCoordinate();
+                if(i>0 && sides[(first+i-1)%k].second==side.second)
+                    portalTo.back() = to;
+                else  {
+                    neighbours.push_back(side.second);
+                    portalFrom.push_back(side.first->getOriginVertex()->getCoordinate());
+                    portalTo.push_back(to);
+                }
+            }
+            offsets.push_back(neighbours.size());
+        }
+    }
+
+    /**
+     * @brief Returns the number of faces
+     */
+    int size() const  {
+        return faceIds.size();
+    }
+
+    /**
+     * @brief Returns the number of adjacencies, every pair of neighbouring faces is counted from both sides
+     */
+    int edgeCount() const  {
+        return neighbours.size();
+    }
+
+    /**
+     * @brief Returns the id of the face at index f, as set in the DCEL
+     */
+    int getFaceId(int f) const  {
+        return faceIds[f];
+    }
+
+    /**
+     * @brief Returns the first entry of face f
+     */
+    int begin(int f) const  {
+        return offsets[f];
+    }
+
+    /**
+     * @brief Returns the entry after the last one of face f
+     */
+    int end(int f) const  {
+        return offsets[f+1];
+    }
+
+    /**
+     * @brief Returns the face across entry k, an index into getFaces()
+     */
+    int getNeighbour(int k) const  {
+        return neighbours[k];
+    }
+
+    /**
+     * @brief Returns the start of the portal of entry k, clockwise around the face it belongs to
+     */
+    pair<C,C> getPortalFrom(int k) const  {
+        return portalFrom[k];
+    }
+
+    /**
+     * @brief Returns the end of the portal of entry k, clockwise around the face it belongs to
+     */
+    pair<C,C> getPortalTo(int k) const  {
+        return portalTo[k];
+    }
+
+    /**
+     * @brief Returns the size()+1 offsets of the neighbour lists
+     */
+    const vector<int>& getOffsets() const  {
+        return offsets;
+    }
+
+    /**
+     * @brief Returns the neighbour lists of all faces one after another
+     */
+    const vector<int>& getNeighbours() const  {
+        return neighbours;
+    }
+};
+
+#endif
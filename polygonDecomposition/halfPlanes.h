@@ -0,0 +1,238 @@
+/*
+Header File halfPlanes.h
+usage- #include "halfPlanes.h" (after dcel.h), build with -mavx2 (or the default SSE2 on x86-64) for the vector kernels
+
+Every face of the decomposition is convex, so a point lies in it exactly when it is on the inner side of all
+of its edges. The edges are turned once into half-planes a*x + b*y + c >= 0 and stored face by face as
+struct-of-arrays blocks (all a, then all b, then all c) padded to HALF_PLANE_WIDTH entries with planes that
+hold everywhere and aligned to 64 bytes, so the kernels below run without branches or remainder loops.
+The planes are taken relative to the first vertex of their face, which keeps the offsets c small enough
+for float; points within a float rounding of an edge may still be classified either way.
+*/
+
+/**
+
+*@file halfPlanes.h
+*@brief Half-plane struct-of-arrays export of the convex faces, with AVX2/SSE point classification kernels.
+
+*/
+
+#ifndef HALF_PLANES_H
+#define HALF_PLANES_H
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Number of planes per padded block, the widest vector used (8 floats for AVX2)
+ */
+#define HALF_PLANE_WIDTH 8
+
+/**
+ * @class HalfPlaneBlocks
+ * @brief Padded, aligned half-plane blocks of the faces of a decomposition
+ * @tparam C coordinate type of the DCEL, the planes are always stored as float
+ *
+ * Usage-
+ *     HalfPlaneBlocks<float> planes(decomposition);
+ *     planes.classifyPoints(f, xs, ys, count, inside);   // inside[i] = 1 if point i lies in face f
+ *     bool isIn = planes.containsPoint(f, x, y);
+ */
+template <class C>
+class HalfPlaneBlocks  {
+private:
+    vector<float> storage;
+    //index of the first 64 byte aligned float of storage
+    size_t alignment = 0;
+    //face f has planeCounts[f] planes padded to a multiple of HALF_PLANE_WIDTH, a at blockOffsets[f], then b, then c
+    vector<size_t> blockOffsets;
+    vector<int> planeCounts;
+    vector<float> originX, originY;
+    vector<int> faceIds;
+
+    static size_t paddedCount(int count)  {
+        return (count+HALF_PLANE_WIDTH-1)/HALF_PLANE_WIDTH*HALF_PLANE_WIDTH;
+    }
+
+public:
+    /**
+     * @brief Builds the blocks
+     * @brief O(n) time and space where n is the number of face vertices
+     * @param decomposition decomposition with convex clockwise faces
+     */
+    HalfPlaneBlocks(DCEL<C>* decomposition)  {
+        vector<Face<C>*> faces = decomposition->getFaces();
+        size_t total = 0;
+        vector<vector<pair<double,double>>> rings;
+        for(auto face: faces)  {
+            vector<pair<double,double>> ring;
+            Edge<C>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+            do  {
+                ring.push_back({edge->getOriginVertex()->getCoordinate().first, edge->getOriginVertex()->getCoordinate().second});
+                edge=edge->getNextEdge();
+            }while(edge!=fixEdge);
+            blockOffsets.push_back(total);
+            planeCounts.push_back(ring.size());
+            faceIds.push_back(face->getId());
+            total += 3*paddedCount(ring.size());
+            rings.push_back(ring);
+        }
+        storage.assign(total+64/sizeof(float), 0);
+        alignment = (64-(uintptr_t)storage.data()%64)%64/sizeof(float);
+        float* base = storage.data()+alignment;
+
+        for(int f = 0; f<rings.size(); f++)  {
+            vector<pair<double,double>> &ring = rings[f];
+            size_t padded = paddedCount(ring.size());
+            float* a = base+blockOffsets[f], *b = a+padded, *c = b+padded;
+            originX.push_back(ring[0].first);
+            originY.push_back(ring[0].second);
+            for(int i = 0; i<ring.size(); i++)  {
+                pair<double,double> p = ring[i], q = ring[(i+1)%ring.size()];
+                //inner side of a clockwise edge p->q is its right, (q-p) x (x-p) <= 0
+                double planeA = q.second-p.second, planeB = p.first-q.first;
+                a[i] = planeA;
+                b[i] = planeB;
+                c[i] = -(planeA*(p.first-ring[0].first)+planeB*(p.second-ring[0].second));
+            }
+            //padding planes 0*x + 0*y + 1 >= 0 hold everywhere
+            for(int i = ring.size(); i<padded; i++)
+                c[i] = 1;
+        }
+    }
+
+    //alignment is an offset into the buffer of storage: a copy gets a buffer of its own, aligned differently, while a
+    //move keeps the buffer
+    HalfPlaneBlocks(const HalfPlaneBlocks&)=delete;
+    HalfPlaneBlocks& operator=(const HalfPlaneBlocks&)=delete;
+    HalfPlaneBlocks(HalfPlaneBlocks&&)=default;
+    HalfPlaneBlocks& operator=(HalfPlaneBlocks&&)=default;
+
+    /**
+     * @brief Returns the number of faces
+     */
+    int size() const  {
+        return planeCounts.size();
+    }
+
+    /**
+     * @brief Returns the id of face f, as set in the DCEL
+     */
+    int getFaceId(int f) const  {
+        return faceIds[f];
+    }
+
+    /**
+     * @brief Returns the number of planes of face f, padded to a multiple of HALF_PLANE_WIDTH
+     */
+    size_t getPlaneCount(int f) const  {
+        return paddedCount(planeCounts[f]);
+    }
+
+    /**
+     * @brief Returns the 64 byte aligned a, b and c arrays of face f, getPlaneCount(f) entries each
+     */
+    const float* getA(int f) const  {
+        return storage.data()+alignment+blockOffsets[f];
+    }
+
+    const float* getB(int f) const  {
+        return getA(f)+getPlaneCount(f);
+    }
+
+    const float* getC(int f) const  {
+        return getA(f)+2*getPlaneCount(f);
+    }
+
+    /**
+     * @brief Returns the point the planes of face f are relative to, queries subtract it first
+     */
+    pair<float,float> getOrigin(int f) const  {
+        return {originX[f], originY[f]};
+    }
+
+    /**
+     * @brief Checks one point against face f, vectorised over the planes
+     * @brief O(k) time where k is the number of planes of the face, no branches inside the loop
+     */
+    bool containsPoint(int f, float x, float y) const  {
+        const float* a = getA(f), *b = getB(f), *c = getC(f);
+        size_t count = getPlaneCount(f);
+        x -= originX[f];
+        y -= originY[f];
+#if defined(__AVX2__)
+        __m256 px = _mm256_set1_ps(x), py = _mm256_set1_ps(y), outside = _mm256_setzero_ps();
+        for(size_t i = 0; i<count; i += 8)  {
+            __m256 value = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(a+i), px), _mm256_mul_ps(_mm256_load_ps(b+i), py)), _mm256_load_ps(c+i));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(value, _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        return _mm256_movemask_ps(outside)==0;
+#elif defined(__SSE2__)
+        __m128 px = _mm_set1_ps(x), py = _mm_set1_ps(y), outside = _mm_setzero_ps();
+        for(size_t i = 0; i<count; i += 4)  {
+            __m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(a+i), px), _mm_mul_ps(_mm_load_ps(b+i), py)), _mm_load_ps(c+i));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(value, _mm_setzero_ps()));
+        }
+        return _mm_movemask_ps(outside)==0;
+#else
+        bool isInside = true;
+        for(size_t i = 0; i<count; i++)
+            isInside &= a[i]*x+b[i]*y+c[i]>=0;
+        return isInside;
+#endif
+    }
+
+    /**
+     * @brief Classifies a batch of points against face f, vectorised over the points
+     * @brief O(m k) time for m points and k planes, no branches inside the loops
+     * @param f face index
+     * @param xs x coordinates
+     * @param ys y coordinates
+     * @param count number of points
+     * @param inside output, count entries, 1 if the point lies in the face (or on its boundary) and 0 otherwise
+     */
+    void classifyPoints(int f, const float* xs, const float* ys, size_t count, uint8_t* inside) const  {
+        const float* a = getA(f), *b = getB(f), *c = getC(f);
+        int planes = planeCounts[f];
+        float ox = originX[f], oy = originY[f];
+        size_t i = 0;
+#if defined(__AVX2__)
+        __m256 vox = _mm256_set1_ps(ox), voy = _mm256_set1_ps(oy);
+        for(; i+8<=count; i += 8)  {
+            __m256 px = _mm256_sub_ps(_mm256_loadu_ps(xs+i), vox), py = _mm256_sub_ps(_mm256_loadu_ps(ys+i), voy);
+            __m256 outside = _mm256_setzero_ps();
+            for(int j = 0; j<planes; j++)  {
+                __m256 value = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a[j]), px), _mm256_mul_ps(_mm256_set1_ps(b[j]), py)), _mm256_set1_ps(c[j]));
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(value, _mm256_setzero_ps(), _CMP_LT_OQ));
+            }
+            int mask = ~_mm256_movemask_ps(outside);
+            for(int k = 0; k<8; k++)
+                inside[i+k] = (mask>>k)&1;
+        }
+#elif defined(__SSE2__)
+        __m128 vox = _mm_set1_ps(ox), voy = _mm_set1_ps(oy);
+        for(; i+4<=count; i += 4)  {
+            __m128 px = _mm_sub_ps(_mm_loadu_ps(xs+i), vox), py = _mm_sub_ps(_mm_loadu_ps(ys+i), voy);
+            __m128 outside = _mm_setzero_ps();
+            for(int j = 0; j<planes; j++)  {
+                __m128 value = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[j]), px), _mm_mul_ps(_mm_set1_ps(b[j]), py)), _mm_set1_ps(c[j]));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(value, _mm_setzero_ps()));
+            }
+            int mask = ~_mm_movemask_ps(outside);
+            for(int k = 0; k<4; k++)
+                inside[i+k] = (mask>>k)&1;
+        }
+#endif
+        //remaining points, and every point without vector units
+        for(; i<count; i++)  {
+            float px = xs[i]-ox, py = ys[i]-oy;
+            bool isInside = true;
+            for(int j = 0; j<planes; j++)
+                isInside &= a[j]*px+b[j]*py+c[j]>=0;
+            inside[i] = isInside;
+        }
+    }
+};
+
+#endif
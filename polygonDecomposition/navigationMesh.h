@@ -0,0 +1,343 @@
+/*
+Header File navigationMesh.h
+usage- #include "navigationMesh.h" (after pointLocation.h and dualGraph.h)
+
+Path queries over a finished decomposition used as a navigation mesh. The faces holding the two ends are found with a
+FaceLocator, the chain of faces between them is found over the DualGraph, and the chain of portals crossed is pulled
+taut with the funnel algorithm (string pulling), which gives the shortest path through that chain of faces.
+Cutting a polygon along diagonals leaves a tree of faces, so the chain is the only one: it is read off the tree by
+walking both ends up to their common ancestor, in time proportional to its length, and the path is the shortest inside
+the polygon. Where rectangle cuts meet inside the polygon the faces can form cycles; A* then runs over the faces, each
+entered at the midpoint of the portal it was reached through, and may pick a chain slightly longer than the best.
+The search keeps its state in a Scratch stamped per query, so a query allocates nothing once the scratch has grown to
+the mesh; batches are spread over threads each owning one scratch.
+*/
+
+/**
+
+*@file navigationMesh.h
+*@brief A* over the dual graph of a decomposition with funnel path smoothing, single and batched parallel queries.
+
+*/
+
+#ifndef NAVIGATION_MESH_H
+#define NAVIGATION_MESH_H
+
+/**
+ * @brief Queries a thread of NavigationMesh::findPaths takes at a time
+ */
+#define NAVIGATION_BATCH 64
+
+/**
+ * @class NavigationMesh
+ * @brief Shortest path queries between points of a decomposed polygon
+ * @tparam C coordinate type of the DCEL
+ *
+ * Usage-
+ *     NavigationMesh<float> mesh(decomposition);
+ *     NavigationMesh<float>::Scratch scratch;                 // one per thread
+ *     vector<pair<float,float>> path;
+ *     if(mesh.findPath(start, goal, scratch, path)) ...      // corners from start to goal
+ *     mesh.findPaths(starts, goals, paths, threads);          // a batch, empty paths where there is none
+ */
+template <class C>
+class NavigationMesh  {
+public:
+    /**
+     * @struct Scratch
+     * @brief Working memory of one query at a time, reused across queries
+     */
+    struct Scratch  {
+        //a face holds data of the current query only if its stamp is the current one
+        vector<unsigned> stamp;
+        unsigned current = 0;
+        vector<double> cost;
+        //point the face was entered at, the start in the first face
+        vector<pair<double,double>> entry;
+        //entry of the dual graph crossed into the face, -1 in the first face
+        vector<int> through;
+        vector<char> isClosed;
+        vector<pair<double,int>> heap;
+        vector<pair<double,double>> lefts, rights, downLefts, downRights;
+    };
+
+private:
+    FaceLocator<C> locator;
+    DualGraph<C> dual;
+    //every dual graph entry seen from the face it belongs to, crossing it: its face, its left and right end and its midpoint
+    vector<int> entryFace;
+    vector<pair<double,double>> portalLeft, portalRight, portalMiddle;
+    //when the faces form a tree, rooted at face 0: the depth of every face and the entry of its parent leading to it
+    bool isTree = false;
+    vector<int> depth, parentEntry;
+
+    /**
+     * @brief Twice the signed area of the triangle a b c, positive when c lies left of a -> b
+     */
+    static double cross(const pair<double,double> &a, const pair<double,double> &b, const pair<double,double> &c)  {
+        return (b.first-a.first)*(c.second-a.second)-(b.second-a.second)*(c.first-a.first);
+    }
+
+    static double distance(const pair<double,double> &a, const pair<double,double> &b)  {
+        double dx = a.first-b.first, dy = a.second-b.second;
+        return sqrt(dx*dx+dy*dy);
+    }
+
+    /**
+     * @brief Finds the chain of faces between two faces with A* and lists the portals crossed, start first
+     * @return false if the faces are not connected
+     */
+    bool searchChain(int first, int last, const pair<double,double> &from, const pair<double,double> &to, Scratch &scratch) const;
+
+    /**
+     * @brief Lists the portals crossed between two faces of a tree, start first
+     * @brief O(p) time where p is the number of faces of the chain
+     */
+    void treeChain(int first, int last, Scratch &scratch) const  {
+        //crossing up from a face through the entry its parent leads to it by is crossing that entry backwards
+        scratch.downLefts.clear();
+        scratch.downRights.clear();
+        int u = first, v = last;
+        while(u!=v)  {
+            if(depth[u]>=depth[v])  {
+                int k = parentEntry[u];
+                scratch.lefts.push_back(portalRight[k]);
+                scratch.rights.push_back(portalLeft[k]);
+                u = entryFace[k];
+            }
+            else  {
+                int k = parentEntry[v];
+                scratch.downLefts.push_back(portalLeft[k]);
+                scratch.downRights.push_back(portalRight[k]);
+                v = entryFace[k];
+            }
+        }
+        scratch.lefts.insert(scratch.lefts.end(), scratch.downLefts.rbegin(), scratch.downLefts.rend());
+        scratch.rights.insert(scratch.rights.end(), scratch.downRights.rbegin(), scratch.downRights.rend());
+    }
+
+public:
+    /**
+     * @brief Builds the point location index and the dual graph of a decomposition
+     * @brief O(E) expected time for the dual graph plus the time of the FaceLocator, O(E) space
+     */
+    NavigationMesh(DCEL<C>* decomposition) : locator(decomposition), dual(decomposition)  {
+        for(int f = 0; f<dual.size(); f++)
+            for(int k = dual.begin(f); k<dual.end(f); k++)  {
+                //faces run clockwise, so crossing a portal out of its face its first end is on the left
+                pair<double,double> left = dual.getPortalFrom(k), right = dual.getPortalTo(k);
+                entryFace.push_back(f);
+                portalLeft.push_back(left);
+                portalRight.push_back(right);
+                portalMiddle.push_back({(left.first+right.first)/2, (left.second+right.second)/2});
+            }
+        int faceCount = dual.size();
+        if(faceCount==0 || dual.edgeCount()!=2*(faceCount-1))
+            return;
+        //as many adjacencies as a tree has, it is one if they all hang together
+        depth.assign(faceCount, -1);
+        parentEntry.assign(faceCount, -1);
+        vector<int> queue = {0};
+        depth[0] = 0;
+        for(size_t i = 0; i<queue.size(); i++)  {
+            int f = queue[i];
+            for(int k = dual.begin(f); k<dual.end(f); k++)  {
+                int g = dual.getNeighbour(k);
+                if(depth[g]<0)  {
+                    depth[g] = depth[f]+1;
+                    parentEntry[g] = k;
+                    queue.push_back(g);
+                }
+            }
+        }
+        isTree = (int)queue.size()==faceCount;
+    }
+
+    /**
+     * @brief Returns the number of faces
+     */
+    int size() const  {
+        return dual.size();
+    }
+
+    /**
+     * @brief Finds a short path between two points inside the polygon
+     * @brief O(p) time on a tree of faces where p is the number of portals crossed, otherwise O(F log F) for A* in the
+     * worst case where F is the number of faces, plus O(p) for the funnel; no allocation once the scratch has grown to the mesh
+     * @param start first point
+     * @param goal last point
+     * @param scratch working memory, owned by the calling thread
+     * @param path set to the corners of the path, start and goal included
+     * @return false, with an empty path, if a point is outside the polygon or the faces are not connected
+     */
+    bool findPath(pair<C,C> start, pair<C,C> goal, Scratch &scratch, vector<pair<C,C>> &path) const  {
+        path.clear();
+        int first = locator.locate(start), last = locator.locate(goal);
+        if(first<0 || last<0)
+            return false;
+        pair<double,double> from = start, to = goal;
+        //portals from the start to the goal, the two ends are portals of zero width
+        scratch.lefts.assign(1, from);
+        scratch.rights.assign(1, from);
+        if(isTree)
+            treeChain(first, last, scratch);
+        else if(!searchChain(first, last, from, to, scratch))
+            return false;
+        scratch.lefts.push_back(to);
+        scratch.rights.push_back(to);
+
+        //funnel: the apex sees every later portal between the left and right sides, a side that would cross the other
+        //turns the path around its end, which becomes the next apex
+        path.push_back(start);
+        pair<double,double> apex = from, left = from, right = from;
+        int leftIndex = 0, rightIndex = 0;
+        int count = scratch.lefts.size();
+        for(int i = 1; i<count; i++)  {
+            pair<double,double> &nextLeft = scratch.lefts[i], &nextRight = scratch.rights[i];
+            if(cross(apex, right, nextRight)>=0)  {
+                if(apex==right || cross(apex, left, nextRight)<0)  {
+                    right = nextRight;
+                    rightIndex = i;
+                }
+                else  {
+                    path.push_back({(C)left.first, (C)left.second});
+                    apex = right = left;
+                    i = rightIndex = leftIndex;
+                    continue;
+                }
+            }
+            if(cross(apex, left, nextLeft)<=0)  {
+                if(apex==left || cross(apex, right, nextLeft)>0)  {
+                    left = nextLeft;
+                    leftIndex = i;
+                }
+                else  {
+                    path.push_back({(C)right.first, (C)right.second});
+                    apex = left = right;
+                    i = leftIndex = rightIndex;
+                    continue;
+                }
+            }
+        }
+        if(path.back()!=goal)
+            path.push_back(goal);
+        return true;
+    }
+
+    /**
+     * @brief Answers a batch of path queries on several threads
+     * @brief O(q p / t) time for q queries on t threads on a tree of faces, see findPath
+     * @param starts first point of every query
+     * @param goals last point of every query
+     * @param paths set to one path per query as findPath gives it, empty where there is none
+     * @param threadCount threads to use, at least 1
+     */
+    void findPaths(const vector<pair<C,C>> &starts, const vector<pair<C,C>> &goals, vector<vector<pair<C,C>>> &paths, int threadCount) const  {
+        size_t count = min(starts.size(), goals.size());
+        paths.assign(count, vector<pair<C,C>>());
+        atomic<size_t> next(0);
+        auto work = [&]()  {
+            Scratch scratch;
+            while(true)  {
+                size_t first = next.fetch_add(NAVIGATION_BATCH);
+                if(first>=count)
+                    break;
+                for(size_t q = first; q<min(count, first+NAVIGATION_BATCH); q++)
+                    findPath(starts[q], goals[q], scratch, paths[q]);
+            }
+        };
+        vector<thread> workers;
+        for(int t = 1; t<threadCount; t++)
+            workers.push_back(thread(work));
+        work();
+        for(auto &worker: workers)
+            worker.join();
+    }
+
+    /**
+     * @brief Returns the length of a path
+     */
+    static double pathLength(const vector<pair<C,C>> &path)  {
+        double length = 0;
+        for(size_t i = 1; i<path.size(); i++)
+            length += hypot((double)path[i].first-path[i-1].first, (double)path[i].second-path[i-1].second);
+        return length;
+    }
+};
+
+/**
+ * @brief A* over the faces, each entered at the midpoint of the portal it was reached through
+ * @brief O(F log F) time in the worst case where F is the number of faces, no allocation once the scratch has grown to the mesh
+ * @param first face of the start
+ * @param last face of the goal
+ * @param from start
+ * @param to goal
+ * @param scratch working memory, the portals crossed are appended to its lefts and rights
+ * @return false if the faces are not connected
+ */
+template <class C>
+bool NavigationMesh<C>::searchChain(int first, int last, const pair<double,double> &from, const pair<double,double> &to, Scratch &scratch) const  {
+    int faceCount = dual.size();
+    if((int)scratch.stamp.size()!=faceCount)  {
+        scratch.stamp.assign(faceCount, 0);
+        scratch.cost.resize(faceCount);
+        scratch.entry.resize(faceCount);
+        scratch.through.resize(faceCount);
+        scratch.isClosed.resize(faceCount);
+        scratch.current = 0;
+    }
+    //after 2^32 queries the stamps wrap around, they are cleared once then
+    if(++scratch.current==0)  {
+        fill(scratch.stamp.begin(), scratch.stamp.end(), 0);
+        scratch.current = 1;
+    }
+    //A* from the start face, a face is entered at the midpoint of the portal crossed
+    scratch.heap.clear();
+    scratch.stamp[first] = scratch.current;
+    scratch.cost[first] = 0;
+    scratch.entry[first] = from;
+    scratch.through[first] = -1;
+    scratch.isClosed[first] = 0;
+    scratch.heap.push_back({-distance(from, to), first});
+    bool isReached = false;
+    while(!scratch.heap.empty())  {
+        pop_heap(scratch.heap.begin(), scratch.heap.end());
+        int f = scratch.heap.back().second;
+        scratch.heap.pop_back();
+        if(scratch.isClosed[f])
+            continue;
+        if(f==last)  {
+            isReached = true;
+            break;
+        }
+        scratch.isClosed[f] = 1;
+        for(int k = dual.begin(f); k<dual.end(f); k++)  {
+            int g = dual.getNeighbour(k);
+            double cost = scratch.cost[f]+distance(scratch.entry[f], portalMiddle[k]);
+            bool isSeen = scratch.stamp[g]==scratch.current;
+            if(isSeen && (scratch.isClosed[g] || scratch.cost[g]<=cost))
+                continue;
+            scratch.stamp[g] = scratch.current;
+            scratch.cost[g] = cost;
+            scratch.entry[g] = portalMiddle[k];
+            scratch.through[g] = k;
+            scratch.isClosed[g] = 0;
+            //the heap is a max heap of negated estimates
+            scratch.heap.push_back({-(cost+distance(portalMiddle[k], to)), g});
+            push_heap(scratch.heap.begin(), scratch.heap.end());
+        }
+    }
+    if(!isReached)
+        return false;
+    //the chain is walked back from the goal, so it is reversed after the start
+    size_t chainStart = scratch.lefts.size();
+    for(int f = last; scratch.through[f]>=0; f = entryFace[scratch.through[f]])  {
+        scratch.lefts.push_back(portalLeft[scratch.through[f]]);
+        scratch.rights.push_back(portalRight[scratch.through[f]]);
+    }
+    reverse(scratch.lefts.begin()+chainStart, scratch.lefts.end());
+    reverse(scratch.rights.begin()+chainStart, scratch.rights.end());
+    return true;
+}
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file parserBenchmark.cpp
+ * @brief Compares the throughput (MB/s) of the iostream loader formerly used in main with TextPolygonReader.
+ *
+ * usage- ./parserBenchmark [file] [repetitions]
+ * Without a file a 1,000,000 vertex polygon is generated in input_format.txt layout first.
+ */
+
+#include <bits/stdc++.h>
+using namespace std;
+
+#include "../dcel/dcel.h"
+#include "dualGraph.h"
+#include "polygonFormats.h"
+
+#define T float
+
+/**
+ * @brief Writes a star shaped polygon of n vertices in clockwise order
+ * @brief O(n) time and O(1) space
+ */
+
+void generateInput(string fileName, int n)  {
+    ofstream out(fileName);
+    mt19937 random(12345);
+    uniform_real_distribution<double> radius(50.0, 100.0);
+    out<<n<<"\n"<<fixed<<setprecision(7);
+    for(int i = 0; i<n; i++)  {
+        double angle = -2*M_PI*i/n;
+        double r = radius(random);
+        out<<"v"<<i<<" "<<r*cos(angle)<<" "<<r*sin(angle)<<"\n";
+    }
+}
+
+/**
+ * @brief The loader main used before TextPolygonReader, one string and two iostream conversions per vertex
+ */
+
+size_t loadWithIostream(string fileName, vector<string> &ids, vector<pair<T,T>> &coordinates)  {
+    ifstream fin(fileName);
+    int numberOfVertices;
+    fin>>numberOfVertices;
+    for(int i = 0; i<numberOfVertices; i++)  {
+        string id;
+        pair<T,T> coordinate;
+        fin>>id>>coordinate.first>>coordinate.second;
+        ids.push_back(id);
+        coordinates.push_back(coordinate);
+    }
+    return coordinates.size();
+}
+
+/**
+ * @brief The buffer based loader
+ */
+
+size_t loadWithReader(string fileName, double &checksum, bool internIds)  {
+    ifstream fin(fileName, ios::binary);
+    TextPolygonReader<T> reader(fin, 1<<20, internIds);
+    reader.read();
+    for(size_t i = 0; i<reader.size(); i++)
+        checksum += reader.getCoordinate(i).first+reader.getId(i).size();
+    return reader.size();
+}
+
+int main(int argc, char* argv[])  {
+    string fileName = argc>1 ? argv[1] : "parserBenchmark_input.txt";
+    int repetitions = argc>2 ? atoi(argv[2]) : 5;
+    if(argc<=1)
+        generateInput(fileName, 1000000);
+
+    ifstream sizeProbe(fileName, ios::binary|ios::ate);
+    double megabytes = sizeProbe.tellg()/1e6;
+
+    double bestIostream = 1e18, bestReader = 1e18, bestReaderTrusted = 1e18;
+    size_t vertices = 0;
+    for(int r = 0; r<repetitions; r++)  {
+        vector<string> ids;
+        vector<pair<T,T>> coordinates;
+        auto start = chrono::steady_clock::now();
+        vertices = loadWithIostream(fileName, ids, coordinates);
+        auto stop = chrono::steady_clock::now();
+        bestIostream = min(bestIostream, chrono::duration<double>(stop-start).count());
+
+        double checksum = 0;
+        start = chrono::steady_clock::now();
+        size_t parsed = loadWithReader(fileName, checksum, true);
+        stop = chrono::steady_clock::now();
+        bestReader = min(bestReader, chrono::duration<double>(stop-start).count());
+        if(parsed!=vertices)
+            cerr<<"Vertex counts differ: "<<vertices<<" vs "<<parsed<<"\n";
+
+        start = chrono::steady_clock::now();
+        loadWithReader(fileName, checksum, false);
+        stop = chrono::steady_clock::now();
+        bestReaderTrusted = min(bestReaderTrusted, chrono::duration<double>(stop-start).count());
+    }
+
+    cout<<fixed<<setprecision(1);
+    cout<<fileName<<": "<<vertices<<" vertices, "<<megabytes<<" MB, best of "<<repetitions<<"\n";
+    cout<<"iostream loader    "<<megabytes/bestIostream<<" MB/s\n";
+    cout<<"TextPolygonReader  "<<megabytes/bestReader<<" MB/s ("<<bestIostream/bestReader<<"x)\n";
+    cout<<"  without interning "<<megabytes/bestReaderTrusted<<" MB/s ("<<bestIostream/bestReaderTrusted<<"x)\n";
+    return 0;
+}
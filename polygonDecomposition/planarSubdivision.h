@@ -0,0 +1,181 @@
+/*
+Header File planarSubdivision.h
+usage- #include "planarSubdivision.h" (after dcel.h)
+
+A map layer of parcels sharing boundaries, held on one table of unique vertices. Every ring added is interned
+point by point, so a corner shared by several parcels is stored once and the parcels are kept as runs of vertex
+indices in compressed sparse row form (ring p is ringVertices[ringOffsets[p] .. ringOffsets[p+1])). Once the
+parcels are decomposed, build turns all their faces into one DCEL on the shared vertices, the two sides of every
+edge walked by two faces being twins: the diagonals inside a parcel as well as the boundaries between parcels.
+Parcels have to meet vertex to vertex; a corner of one parcel lying inside an edge of its neighbour (a T-junction)
+leaves that stretch of boundary without twins.
+*/
+
+/**
+
+*@file planarSubdivision.h
+*@brief Planar subdivision on shared vertices, decomposed faces rebuilt as one DCEL twinned across parcel boundaries.
+
+*/
+
+#ifndef PLANAR_SUBDIVISION_H
+#define PLANAR_SUBDIVISION_H
+
+/**
+ * @class PlanarSubdivision
+ * @brief Parcels of a map layer on a shared vertex table
+ * @tparam C coordinate type of the DCEL
+ *
+ * Usage-
+ *     PlanarSubdivision<float> subdivision;
+ *     int p = subdivision.addRing(ring);                       // clockwise, as the readers hand it over
+ *     for(int k = subdivision.begin(p); k<subdivision.end(p); k++)
+ *         subdivision.getVertex(k), subdivision.getCoordinate(subdivision.getVertex(k));
+ *     DCEL<float>* decomposition = subdivision.build(faces);    // faces as clockwise runs of vertex indices
+ */
+template <class C>
+class PlanarSubdivision  {
+private:
+    struct CoordinateHash  {
+        size_t operator()(const pair<C,C> &coordinate) const  {
+            return hash<C>()(coordinate.first)*1000003u^hash<C>()(coordinate.second);
+        }
+    };
+    vector<pair<C,C>> coordinates;
+    unordered_map<pair<C,C>, int, CoordinateHash> vertexIndex;
+    vector<int> ringOffsets = {0};
+    vector<int> ringVertices;
+    long long sharedEdges = 0, conflictingEdges = 0;
+
+public:
+    /**
+     * @brief Adds a parcel, interning its vertices
+     * @brief O(k) expected time where k is the number of vertices of the ring
+     * @param ring clockwise ring without the repeated closing point, a point repeated one after the other is kept once
+     * @return index of the parcel
+     */
+    int addRing(const vector<pair<C,C>> &ring)  {
+        int first = ringVertices.size();
+        for(auto coordinate: ring)  {
+            //-0 and 0 are the same point but hash apart
+            coordinate = {coordinate.first+(C)0, coordinate.second+(C)0};
+            auto inserted = vertexIndex.insert({coordinate, (int)coordinates.size()});
+            if(inserted.second)
+                coordinates.push_back(coordinate);
+            int v = inserted.first->second;
+            if((int)ringVertices.size()==first || ringVertices.back()!=v)
+                ringVertices.push_back(v);
+        }
+        while((int)ringVertices.size()>first+1 && ringVertices.back()==ringVertices[first])
+            ringVertices.pop_back();
+        ringOffsets.push_back(ringVertices.size());
+        return ringOffsets.size()-2;
+    }
+
+    /**
+     * @brief Returns the number of parcels
+     */
+    int size() const  {
+        return ringOffsets.size()-1;
+    }
+
+    /**
+     * @brief Returns the number of unique vertices
+     */
+    int vertexCount() const  {
+        return coordinates.size();
+    }
+
+    /**
+     * @brief Returns the first position of parcel p
+     */
+    int begin(int p) const  {
+        return ringOffsets[p];
+    }
+
+    /**
+     * @brief Returns the position after the last one of parcel p
+     */
+    int end(int p) const  {
+        return ringOffsets[p+1];
+    }
+
+    /**
+     * @brief Returns the vertex at position k of the rings
+     */
+    int getVertex(int k) const  {
+        return ringVertices[k];
+    }
+
+    /**
+     * @brief Returns the coordinate of vertex v
+     */
+    pair<C,C> getCoordinate(int v) const  {
+        return coordinates[v];
+    }
+
+    /**
+     * @brief Returns the number of edge pairs the last build twinned, diagonals and boundaries between parcels
+     */
+    long long getSharedEdges() const  {
+        return sharedEdges;
+    }
+
+    /**
+     * @brief Returns the half edges of the last build walked the same way by two faces, which only overlapping parcels do
+     */
+    long long getConflictingEdges() const  {
+        return conflictingEdges;
+    }
+
+    /**
+     * @brief Builds one DCEL from the faces of every parcel, on the shared vertices
+     * @brief O(V + E) expected time and space where V is the number of unique vertices and E the number of half edges
+     * @param faces clockwise runs of vertex indices, face f getting id f+1
+     * @return Pointer to the DCEL, vertex v having id "v<v>"; it owns its vertices, edges and faces
+     */
+    DCEL<C>* build(const vector<vector<int>> &faces)  {
+        vector<Vertex<C>*> vertices;
+        for(int v = 0; v<(int)coordinates.size(); v++)
+            vertices.push_back(new Vertex<C>("v"+to_string(v), coordinates[v]));
+        vector<Edge<C>*> edges;
+        vector<Face<C>*> dcelFaces;
+        //half edge u -> v under the key u*V+v, its twin is the half edge v -> u
+        unordered_map<long long, Edge<C>*> halfEdges;
+        long long count = coordinates.size();
+        sharedEdges = conflictingEdges = 0;
+        for(auto &ring: faces)  {
+            int k = ring.size();
+            Face<C>* face = new Face<C>(dcelFaces.size()+1, NULL);
+            dcelFaces.push_back(face);
+            int firstEdge = edges.size();
+            for(int i = 0; i<k; i++)  {
+                int u = ring[i], v = ring[(i+1)%k];
+                Edge<C>* edge = new Edge<C>(vertices[u]);
+                edge->setLeftFace(face);
+                edges.push_back(edge);
+                if(!vertices[u]->getIncidentEdge())
+                    vertices[u]->setIncidentEdge(edge);
+                if(!halfEdges.insert({u*count+v, edge}).second)  {
+                    conflictingEdges++;
+                    continue;
+                }
+                auto twin = halfEdges.find(v*count+u);
+                if(twin!=halfEdges.end())  {
+                    edge->setTwinEdge(twin->second);
+                    twin->second->setTwinEdge(edge);
+                    sharedEdges++;
+                }
+            }
+            for(int i = 0; i<k; i++)  {
+                Edge<C>* edge = edges[firstEdge+i], *next = edges[firstEdge+(i+1)%k];
+                edge->setNextEdge(next);
+                next->setPrevEdge(edge);
+            }
+            face->setIncidentEdge(edges[firstEdge]);
+        }
+        return new DCEL<C>(vertices, edges, dcelFaces);
+    }
+};
+
+#endif
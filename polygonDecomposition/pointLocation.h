@@ -0,0 +1,229 @@
+/*
+Header File pointLocation.h
+usage- #include "pointLocation.h" (after dcel.h)
+
+Answers "which convex face contains this point" for a finished decomposition without walking every face.
+The faces are copied once into flat arrays and bucketed into a uniform grid of about two cells per face,
+so a query only tests the few faces overlapping its cell, each with the exact convex containment test
+(the point is on the inner side of, or on, every edge). Cells lying inside a single face are answered
+directly.
+*/
+
+/**
+
+*@file pointLocation.h
+*@brief Uniform grid point-location index over the convex faces of a decomposition, single and batch queries.
+
+*/
+
+#ifndef POINT_LOCATION_H
+#define POINT_LOCATION_H
+
+/**
+ * @class FaceLocator
+ * @brief Point-location index over the faces of a decomposition
+ * @tparam C coordinate type of the DCEL
+ *
+ * Usage-
+ *     FaceLocator<float> locator(decomposition);
+ *     int f = locator.locate({x, y});                  // index into decomposition->getFaces(), -1 outside
+ *     locator.locateBatch(xs, ys, count, faceIndices);  // millions of points, no allocation
+ */
+template <class C>
+class FaceLocator  {
+private:
+    vector<int> faceIds;
+    //face f has the vertices faceX/faceY[faceOffsets[f] .. faceOffsets[f+1]), clockwise
+    vector<int> faceOffsets;
+    vector<double> faceX, faceY;
+    //cell c holds the faces cellFaces[cellOffsets[c] .. cellOffsets[c+1])
+    vector<int> cellOffsets;
+    vector<int> cellFaces;
+    //face covering the whole cell, -1 if there is none; such cells are answered without any test
+    vector<int> cellOwner;
+    double minX = 0, minY = 0, maxX = 0, maxY = 0, cellWidth = 1, cellHeight = 1;
+    int columns = 1, rows = 1;
+
+    /**
+     * @brief Column or row of a coordinate, clamped to the grid
+     */
+    static int cellOf(double value, double origin, double size, int count)  {
+        int cell = (int)((value-origin)/size);
+        return cell<0 ? 0 : (cell>=count ? count-1 : cell);
+    }
+
+    /**
+     * @brief Exact containment test against one convex clockwise face, points on an edge count as inside
+     * @brief O(k) time where k is the number of vertices of the face
+     */
+    bool isInsideFace(int f, double x, double y) const  {
+        int first = faceOffsets[f], last = faceOffsets[f+1];
+        for(int i = first; i<last; i++)  {
+            int j = i+1==last ? first : i+1;
+            //a point left of a clockwise edge is outside
+            if((faceX[j]-faceX[i])*(y-faceY[i])-(faceY[j]-faceY[i])*(x-faceX[i])>0)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks a face against a cell rectangle, separating axis test on the face edges
+     * @brief O(k) time
+     * @return 0 if they are disjoint, 2 if the cell lies inside the face, 1 otherwise
+     */
+    int cellOverlap(int f, double x0, double y0, double x1, double y1) const  {
+        double cornersX[4] = {x0, x1, x1, x0}, cornersY[4] = {y0, y0, y1, y1};
+        bool isCovered = true;
+        int first = faceOffsets[f], last = faceOffsets[f+1];
+        for(int i = first; i<last; i++)  {
+            int j = i+1==last ? first : i+1;
+            int outside = 0;
+            for(int k = 0; k<4; k++)
+                if((faceX[j]-faceX[i])*(cornersY[k]-faceY[i])-(faceY[j]-faceY[i])*(cornersX[k]-faceX[i])>0)
+                    outside++;
+            if(outside==4)
+                return 0;
+            if(outside>0)
+                isCovered = false;
+        }
+        return isCovered ? 2 : 1;
+    }
+
+public:
+    /**
+     * @brief Builds the index
+     * @brief O(n + f log f + g k) time and O(n + g) space where n is the number of face vertices, f the number of faces and g the number of grid cells the face boxes cover
+     * @param decomposition decomposition with convex clockwise faces
+     */
+    FaceLocator(DCEL<C>* decomposition)  {
+        vector<Face<C>*> faces = decomposition->getFaces();
+        int faceCount = faces.size();
+        faceOffsets.push_back(0);
+        vector<array<double,4>> boxes;
+        for(auto face: faces)  {
+            faceIds.push_back(face->getId());
+            array<double,4> box = {DBL_MAX, DBL_MAX, -DBL_MAX, -DBL_MAX};
+            Edge<C>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+            do  {
+                pair<C,C> coordinate = edge->getOriginVertex()->getCoordinate();
+                faceX.push_back(coordinate.first);
+                faceY.push_back(coordinate.second);
+                box = {min(box[0], (double)coordinate.first), min(box[1], (double)coordinate.second),
+                       max(box[2], (double)coordinate.first), max(box[3], (double)coordinate.second)};
+                edge=edge->getNextEdge();
+            }while(edge!=fixEdge);
+            faceOffsets.push_back(faceX.size());
+            boxes.push_back(box);
+        }
+        if(faceCount==0)  {
+            cellOffsets.assign(2, 0);
+            return;
+        }
+
+        minX = minY = DBL_MAX;
+        maxX = maxY = -DBL_MAX;
+        for(auto &box: boxes)  {
+            minX = min(minX, box[0]);
+            minY = min(minY, box[1]);
+            maxX = max(maxX, box[2]);
+            maxY = max(maxY, box[3]);
+        }
+        //about two cells per face (more for large faces), split between columns and rows so that the face boxes cover the fewest cells,
+        //thin faces all running the same way (combs, histograms) then get cells stretched along them
+        double width = max(maxX-minX, 1e-9), height = max(maxY-minY, 1e-9);
+        int cells = min(1<<24, max(2*faceCount, (int)faceX.size()/2));
+        long long bestCovered = LLONG_MAX;
+        for(int candidate = 1; candidate<=cells; candidate *= 2)  {
+            int candidateRows = max(1, cells/candidate);
+            long long covered = 0;
+            for(auto &box: boxes)
+                covered += (long long)(cellOf(box[2], minX, width/candidate, candidate)-cellOf(box[0], minX, width/candidate, candidate)+1)
+                          *(cellOf(box[3], minY, height/candidateRows, candidateRows)-cellOf(box[1], minY, height/candidateRows, candidateRows)+1);
+            if(covered<bestCovered)  {
+                bestCovered = covered;
+                columns = candidate;
+                rows = candidateRows;
+            }
+        }
+        cellWidth = width/columns;
+        cellHeight = height/rows;
+
+        //counting sort of the (cell, face) pairs into the cell lists, the faces only go to the cells they really overlap
+        cellOffsets.assign(columns*rows+1, 0);
+        cellOwner.assign(columns*rows, -1);
+        for(int pass = 0; pass<2; pass++)  {
+            vector<int> fill;
+            if(pass==1)  {
+                for(int c = 0; c<columns*rows; c++)
+                    cellOffsets[c+1] += cellOffsets[c];
+                cellFaces.resize(cellOffsets.back());
+                fill.assign(cellOffsets.begin(), cellOffsets.end()-1);
+            }
+            for(int f = 0; f<faceCount; f++)  {
+                int x0 = cellOf(boxes[f][0], minX, cellWidth, columns), x1 = cellOf(boxes[f][2], minX, cellWidth, columns);
+                int y0 = cellOf(boxes[f][1], minY, cellHeight, rows), y1 = cellOf(boxes[f][3], minY, cellHeight, rows);
+                for(int y = y0; y<=y1; y++)
+                    for(int x = x0; x<=x1; x++)  {
+                        int overlap = cellOverlap(f, minX+x*cellWidth, minY+y*cellHeight, minX+(x+1)*cellWidth, minY+(y+1)*cellHeight);
+                        if(overlap==0)
+                            continue;
+                        if(pass==0)
+                            cellOffsets[y*columns+x+1]++;
+                        else
+                            cellFaces[fill[y*columns+x]++] = f;
+                        if(overlap==2)
+                            cellOwner[y*columns+x] = f;
+                    }
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the number of indexed faces
+     */
+    int size() const  {
+        return faceIds.size();
+    }
+
+    /**
+     * @brief Returns the id of the face at index f, as set in the DCEL
+     */
+    int getFaceId(int f) const  {
+        return faceIds[f];
+    }
+
+    /**
+     * @brief Finds the face containing a point
+     * @brief O(k) expected time where k is the number of vertices of the faces sharing the cell of the point
+     * @return index of the face in decomposition->getFaces(), -1 if the point is outside the polygon; a point on a
+     * diagonal gets the first of the two faces found
+     */
+    int locate(pair<C,C> point) const  {
+        double x = point.first, y = point.second;
+        if(faceIds.empty() || x<minX || y<minY || x>maxX || y>maxY)
+            return -1;
+        int c = cellOf(y, minY, cellHeight, rows)*columns+cellOf(x, minX, cellWidth, columns);
+        if(cellOwner[c]>=0)
+            return cellOwner[c];
+        for(int i = cellOffsets[c]; i<cellOffsets[c+1]; i++)
+            if(isInsideFace(cellFaces[i], x, y))
+                return cellFaces[i];
+        return -1;
+    }
+
+    /**
+     * @brief Finds the faces containing a batch of points
+     * @brief O(m k) time for m points, no allocation
+     * @param xs x coordinates
+     * @param ys y coordinates
+     * @param count number of points
+     * @param faceIndices output, count entries, as returned by locate
+     */
+    void locateBatch(const C* xs, const C* ys, size_t count, int* faceIndices) const  {
+        for(size_t i = 0; i<count; i++)
+            faceIndices[i] = locate({xs[i], ys[i]});
+    }
+};
+
+#endif
@@ -22,6 +22,17 @@
 using namespace std;
 
 #include "../dcel/dcel.h"
+#include "decompositionBinary.h"
+#include "dualGraph.h"
+#include "planarSubdivision.h"
+#include "polygonFormats.h"
+#include "pointLocation.h"
+#include "halfPlanes.h"
+#include "navigationMesh.h"
+#include "boundedQueue.h"
+#include "polygonSimplification.h"
+#include "rectangleDecomposition.h"
+#include "traceEvents.h"
 /*Notes
 using a vector is problematic in returnPartition function if we do this clockwise
 To do:
@@ -37,6 +48,66 @@ rewrite the isInsidePolygon code
 ifstream fin;
 ofstream fout;
 
+/**
+ * @brief Runtime options, set from the command line in main
+ * --binary     also write the decomposition in the columnar binary layout (../Outputs/outputDemo<i>.pdcl)
+ * --no-twins   leave the twin array out of the binary output
+ * --face-records  also write every face as one 64 byte record (../Outputs/outputDemo<i>.pfr), implies --max-vertices 7
+ */
+bool binaryOutput = false;
+bool binaryTwins = true;
+bool faceRecordOutput = false;
+/**
+ * --quiet      do not print every partition and intermediate decomposition
+ * --geojson-in <file> / --wkt-in <file>    decompose every polygon of a GeoJSON/WKT file instead of the demo input
+ * --geojson-out <file> / --wkt-out <file>  where the convex faces of streamed polygons go (GeoJSON by default)
+ * --subdivision  the streamed polygons are adjacent parcels of one map layer, decomposed on their shared vertices into one
+ *              DCEL twinned across the parcels (with --binary also written to ../Outputs/subdivision.pdcl)
+ * --svg        draw the outline and the convex faces to ../Visualisations/, one svg per polygon, instead of writing the
+ *              adjacency matrix for visualise.py
+ * --svg-plain  same, without filling the faces
+ * --threads <n>  decomposition workers for streamed polygons and path query workers (default one per hardware thread)
+ * --edits <file>  apply vertex edits to the decomposition incrementally, results in ../Outputs/outputDemo<i>_edits.txt
+ * --locate <file> find the face holding each "x y" point of the file, results in ../Outputs/outputDemo<i>_locations.txt
+ * --check-locate  check every located point against the half-plane kernels of its face (halfPlanes.h), disagreements on stderr
+ * --paths <file> find a short path for each "x1 y1 x2 y2" query of the file, results in ../Outputs/outputDemo<i>_paths.txt
+ * --dual       also write which faces share an edge and along which segment, to ../Outputs/outputDemo<i>_dual.txt and
+ *              as neighbours and portals properties of streamed GeoJSON faces
+ * --keep <k>   keep the k best decompositions instead of only the best, the runners-up go to ../Outputs/outputDemo<i>_alternatives.txt
+ * --memo       cut again the partition an earlier start cut from the same remainder instead of searching for it; the
+ *              decompositions are the same, on most polygons the lookups cost more than the searches they save
+ * --no-rectangles  decompose rectilinear polygons into convex pieces like any other instead of into rectangles
+ * --no-fast-path  send convex polygons and those with one or two notches through the general search too
+ * --exact <r>  decompose polygons with at most r notches into the provably fewest convex pieces, the others are searched as before
+ * --trace <file>  write a timeline of the phases (load, every start, partition and merge, output) as Chrome trace-event JSON
+ * --simplify   drop exactly collinear and repeated vertices before decomposing, the polygon is unchanged
+ * --tolerance <d>  also drop vertices lying within d of the simplified boundary (Douglas-Peucker), implies --simplify
+ * --split <k>  cut large polygons into up to k pieces along balanced diagonals, search the pieces in parallel and merge across the cuts that are not needed
+ * --max-vertices <k>  give no face more than k vertices (at least 3), partitions stop growing and merges stop at k
+ */
+bool printSteps = true;
+string streamInput, streamOutput;
+bool streamInputIsGeoJSON = true, streamOutputIsGeoJSON = true;
+bool subdivisionInput = false;
+bool svgOutput = false, svgColoured = true;
+int streamThreads = 0;
+string editsInput, locateInput, pathsInput;
+bool checkLocations = false;
+bool dualOutput = false;
+int keepDecompositions = 1;
+bool memoizeRemainders = false;
+bool fastPaths = true;
+bool rectangleEngine = true;
+//negative when the exact engine is off
+int exactNotchLimit = -1;
+string traceOutput;
+//negative when the input is decomposed as given
+double simplifyTolerance = -1;
+//1 or less when polygons are searched whole
+int splitPieces = 0;
+//0 when faces may have any number of vertices
+int maxFaceVertices = 0;
+
 /**
  * @brief A macro defining the data type used throughout the code as float. Can be replaced with other datatypes from here itself.
  */
@@ -375,6 +446,64 @@ bool isReflex(Vertex<T>* vertex1, Vertex<T>* vertex2, Vertex<T>* vertex3)  {
     return (x1*y2-x2*y1)<0;
 }
 
+/**
+ * \brief Marks the notches of a polygon in one pass, with the same arithmetic as isReflex
+ * \brief O(n) time and O(n) space; the cross products run over plain coordinate arrays, which the compiler vectorises
+ * \param vertices vertices of the polygon in clockwise order
+ * \return flags, 1 where the angle at vertices[i] is reflex
+ */
+
+vector<char> notchFlags(vector<Vertex<T>*> &vertices)  {
+    int n = vertices.size();
+    //padded with the last vertex in front and the first behind, so the loop has no wrap-around
+    vector<T> xs(n+2), ys(n+2);
+    for(int i = 0; i<n; i++)  {
+        Point coordinate = vertices[i]->getCoordinate();
+        xs[i+1] = coordinate.first;
+        ys[i+1] = coordinate.second;
+    }
+    vector<char> isNotch(n);
+    if(n<3)
+        return isNotch;
+    xs[0] = xs[n];
+    ys[0] = ys[n];
+    xs[n+1] = xs[1];
+    ys[n+1] = ys[1];
+    for(int i = 1; i<=n; i++)  {
+        T x1 = xs[i-1]-xs[i], y1 = ys[i-1]-ys[i];
+        T x2 = xs[i+1]-xs[i], y2 = ys[i+1]-ys[i];
+        isNotch[i-1] = (x1*y2-x2*y1)<0;
+    }
+    return isNotch;
+}
+
+/**
+ * \brief Checks if segments l1 and l2 meet anywhere other than at an endpoint they share
+ * \brief O(1) time and O(1) space
+ * \param l1 line
+ * \param l2 line
+ * \return True or False
+ */
+
+bool segmentsIntersect(line l1, line l2)  {
+    if(l1.p1==l2.p2 || l1.p2==l2.p2)
+        swap(l2.p1, l2.p2);
+    if(l1.p2==l2.p1)
+        swap(l1.p1, l1.p2);
+    if(l1.p1==l2.p1)  {
+        //sharing an endpoint, they only meet elsewhere if they overlap along the same direction
+        Point a = l1.p2, b = l2.p2, s = l1.p1;
+        return direction(s, a, b)==0 && (a.first-s.first)*(b.first-s.first)+(a.second-s.second)*(b.second-s.second)>0;
+    }
+    int dir1 = direction(l1.p1, l1.p2, l2.p1);
+    int dir2 = direction(l1.p1, l1.p2, l2.p2);
+    int dir3 = direction(l2.p1, l2.p2, l1.p1);
+    int dir4 = direction(l2.p1, l2.p2, l1.p2);
+    if(dir1!=dir2 && dir3!=dir4)
+        return true;
+    return (dir1==0 && onLine(l1, l2.p1)) || (dir2==0 && onLine(l1, l2.p2)) || (dir3==0 && onLine(l2, l1.p1)) || (dir4==0 && onLine(l2, l1.p2));
+}
+
 /**
  * \brief Prints the polygon
  * \brief O(n) time where n is the number of edges in the polygon and O(1) space
@@ -416,6 +545,198 @@ void printDecompositon(DCEL<T>* decompositon)  {
     fout<<"\n";
 }
 
+/**
+ * \brief Pads the binary output with zero bytes up to the next 8 byte boundary
+ * \brief O(1) time and O(1) space
+ * \param out binary stream
+ * \param written number of bytes written so far, updated
+ * \return none
+ */
+
+void padBinary(ofstream &out, uint64_t &written)  {
+    static const char zeros[8] = {0};
+    uint64_t aligned = pdclAlign(written);
+    out.write(zeros, aligned-written);
+    written = aligned;
+}
+
+/**
+ * \brief Writes the decomposition in the columnar binary layout described in decompositionBinary.h
+ * \brief O(E) time where E is the number of edges in the decomposition, O(V+E) space
+ * \param decompositon decomposition
+ * \param fileName path of the .pdcl file
+ * \param withTwins whether to write the twin array
+ * \param withIds whether to write the original vertex ids
+ * \return true if the file was written
+ */
+
+bool writeDecompositionBinary(DCEL<T>* decompositon, string fileName, bool withTwins, bool withIds)  {
+    ofstream out(fileName, ios::binary);
+    if(!out)
+        return false;
+
+    //shared vertex table, a vertex is stored once however many faces use it
+    vector<Vertex<T>*> vertices = decompositon->getVertices();
+    unordered_map<Vertex<T>*, uint32_t> vertexIndex;
+    vector<T> coordinates;
+    coordinates.reserve(2*vertices.size());
+    for(auto vertex: vertices)  {
+        if(vertexIndex.count(vertex))
+            continue;
+        vertexIndex[vertex] = coordinates.size()/2;
+        coordinates.push_back(vertex->getCoordinate().first);
+        coordinates.push_back(vertex->getCoordinate().second);
+    }
+
+    //flatten the face cycles, remembering where each half edge landed for the twins
+    vector<uint32_t> faceOffsets;
+    vector<uint32_t> vertexIndices;
+    unordered_map<Edge<T>*, int32_t> edgePosition;
+    for(auto face: decompositon->getFaces())  {
+        faceOffsets.push_back(vertexIndices.size());
+        Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            Vertex<T>* vertex = edge->getOriginVertex();
+            //a vertex only reachable through a face cycle still needs a slot
+            if(!vertexIndex.count(vertex))  {
+                vertexIndex[vertex] = coordinates.size()/2;
+                coordinates.push_back(vertex->getCoordinate().first);
+                coordinates.push_back(vertex->getCoordinate().second);
+            }
+            if(withTwins)
+                edgePosition[edge] = vertexIndices.size();
+            vertexIndices.push_back(vertexIndex[vertex]);
+            edge=edge->getNextEdge();
+        }while(edge!=fixEdge);
+    }
+    faceOffsets.push_back(vertexIndices.size());
+
+    vector<int32_t> twins;
+    if(withTwins)  {
+        twins.assign(vertexIndices.size(), -1);
+        for(auto &it: edgePosition)  {
+            Edge<T>* twin = it.first->getTwinEdge();
+            if(twin && edgePosition.count(twin))
+                twins[it.second] = edgePosition[twin];
+        }
+    }
+
+    //ids are kept in input order of the vertex table
+    vector<uint32_t> idOffsets;
+    string idChars;
+    if(withIds)  {
+        vector<Vertex<T>*> ordered(coordinates.size()/2);
+        for(auto &it: vertexIndex)
+            ordered[it.second] = it.first;
+        for(auto vertex: ordered)  {
+            idOffsets.push_back(idChars.size());
+            idChars += vertex->getId();
+        }
+        idOffsets.push_back(idChars.size());
+    }
+
+    DecompositionBinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "PDCL", 4);
+    header.version = PDCL_VERSION;
+    header.flags = (withTwins ? PDCL_HAS_TWINS : 0) | (withIds ? PDCL_HAS_IDS : 0);
+    header.coordinateSize = sizeof(T);
+    header.vertexCount = coordinates.size()/2;
+    header.faceCount = faceOffsets.size()-1;
+    header.indexCount = vertexIndices.size();
+    header.idBytes = idChars.size();
+
+    //lay the sections out one after another on 8 byte boundaries
+    uint64_t offset = pdclAlign(sizeof(header));
+    header.vertexTableOffset = offset;
+    offset = pdclAlign(offset+coordinates.size()*sizeof(T));
+    header.faceOffsetsOffset = offset;
+    offset = pdclAlign(offset+faceOffsets.size()*sizeof(uint32_t));
+    header.vertexIndicesOffset = offset;
+    offset = pdclAlign(offset+vertexIndices.size()*sizeof(uint32_t));
+    if(withTwins)  {
+        header.twinsOffset = offset;
+        offset = pdclAlign(offset+twins.size()*sizeof(int32_t));
+    }
+    if(withIds)  {
+        header.idOffsetsOffset = offset;
+        offset = pdclAlign(offset+idOffsets.size()*sizeof(uint32_t));
+        header.idCharsOffset = offset;
+    }
+
+    uint64_t written = 0;
+    out.write((const char*)&header, sizeof(header));
+    written += sizeof(header);
+    padBinary(out, written);
+    out.write((const char*)coordinates.data(), coordinates.size()*sizeof(T));
+    written += coordinates.size()*sizeof(T);
+    padBinary(out, written);
+    out.write((const char*)faceOffsets.data(), faceOffsets.size()*sizeof(uint32_t));
+    written += faceOffsets.size()*sizeof(uint32_t);
+    padBinary(out, written);
+    out.write((const char*)vertexIndices.data(), vertexIndices.size()*sizeof(uint32_t));
+    written += vertexIndices.size()*sizeof(uint32_t);
+    if(withTwins)  {
+        padBinary(out, written);
+        out.write((const char*)twins.data(), twins.size()*sizeof(int32_t));
+        written += twins.size()*sizeof(int32_t);
+    }
+    if(withIds)  {
+        padBinary(out, written);
+        out.write((const char*)idOffsets.data(), idOffsets.size()*sizeof(uint32_t));
+        written += idOffsets.size()*sizeof(uint32_t);
+        padBinary(out, written);
+        out.write(idChars.data(), idChars.size());
+    }
+    return (bool)out;
+}
+
+/**
+ * \brief Writes every face as one 64 byte record in the layout described in decompositionBinary.h
+ * \brief O(E) time where E is the number of edges in the decomposition, O(F) space for the F faces
+ * \param decompositon decomposition, with faces of at most FACE_RECORD_VERTICES vertices
+ * \param fileName path of the .pfr file
+ * \return true if the file was written, false also when a face does not fit in a record
+ */
+
+bool writeFaceRecords(DCEL<T>* decompositon, string fileName)  {
+    vector<FaceRecord> records;
+    uint32_t maxVertices = 0;
+    for(auto face: decompositon->getFaces())  {
+        FaceRecord record;
+        memset(&record, 0, sizeof(record));
+        record.id = face->getId();
+        Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            if(record.count==FACE_RECORD_VERTICES)
+                return false;
+            record.x[record.count] = edge->getOriginVertex()->getCoordinate().first;
+            record.y[record.count++] = edge->getOriginVertex()->getCoordinate().second;
+            edge=edge->getNextEdge();
+        }while(edge!=fixEdge);
+        for(int k = record.count; k<FACE_RECORD_VERTICES; k++)  {
+            record.x[k] = record.x[0];
+            record.y[k] = record.y[0];
+        }
+        maxVertices = max(maxVertices, record.count);
+        records.push_back(record);
+    }
+
+    FaceRecordHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "PFCR", 4);
+    header.version = PFR_VERSION;
+    header.recordCount = records.size();
+    header.maxVertices = maxVertices;
+
+    ofstream out(fileName, ios::binary);
+    if(!out)
+        return false;
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)records.data(), records.size()*sizeof(FaceRecord));
+    return (bool)out;
+}
+
 /**
  * \brief Constructs the rectangle given the coordinates of opposite corner points p1 and p2
  * \brief O(1) time and O(1) space
@@ -461,6 +782,40 @@ DCEL<T>* makeRectangle(Point p1,Point p2){
     return rectangle;
 }
 
+/**
+ * \brief Frees a DCEL together with its vertices, edges (including those only reachable from its faces) and faces, each object once
+ * \brief O(n log n) time where n is the number of objects, O(n) space
+ * \param polygon DCEL owning all its objects
+ * \param vertices further vertices to free with it, may repeat those of the DCEL
+ * \param edges further edges to free with it, may repeat those of the DCEL
+ * \return none
+ */
+
+void freeDCEL(DCEL<T>* polygon, vector<Vertex<T>*> vertices = vector<Vertex<T>*>(), vector<Edge<T>*> edges = vector<Edge<T>*>())  {
+    vector<Vertex<T>*> polygonVertices = polygon->getVertices();
+    vector<Edge<T>*> polygonEdges = polygon->getEdges();
+    vertices.insert(vertices.end(), polygonVertices.begin(), polygonVertices.end());
+    edges.insert(edges.end(), polygonEdges.begin(), polygonEdges.end());
+    for(auto face: polygon->getFaces())  {
+        Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            edges.push_back(edge);
+            edge=edge->getNextEdge();
+        }while(edge!=fixEdge);
+        delete face;
+    }
+    //sorting brings the repeated pointers together
+    sort(vertices.begin(), vertices.end());
+    sort(edges.begin(), edges.end());
+    for(int i = 0; i<vertices.size(); i++)
+        if(i==0 || vertices[i]!=vertices[i-1])
+            delete vertices[i];
+    for(int i = 0; i<edges.size(); i++)
+        if(i==0 || edges[i]!=edges[i-1])
+            delete edges[i];
+    delete polygon;
+}
+
 // int findGlobalIndex(Vertex<T>* vertex,vector<Vertex<T>*> originalPolygonVertices){
 //     for(int i=0;i<originalPolygonVertices.size();i++){
 //         if(originalPolygonVertices[i]->getId()==vertex->getId()){
@@ -479,21 +834,121 @@ DCEL<T>* makeRectangle(Point p1,Point p2){
 
 //add the condition to try again with different vertex if no polygon found
 
+/**
+ * \brief Turns a partition found at the start of the polygon into a DCEL and updates the polygon to the relative complement of it
+ * \brief O(n) time and space where n is the number of vertices of the polygon
+ * \param &vertices A vector of vertices holding the polygon
+ * \param &edges A vector of edges holding the connections between the vertices
+ * \param &isNotch notch flags of vertices, kept in step with them
+ * \param start index of the first vertex of the partition in the polygon
+ * \param &partitionVertices the vertices of the partition, the ones of the polygon from start on
+ * \param &partitionEdges the edges of the partition, linked into a cycle
+ * \param countPartition # of the current Partition
+ * \return Pointer to the DCEL object of the partition
+ */
+
+DCEL<T>* splitOffPartition(vector<Vertex<T>*> &vertices, vector<Edge<T>*> &edges, vector<char> &isNotch, int start, vector<Vertex<T>*> &partitionVertices, vector<Edge<T>*> &partitionEdges, int countPartition)  {
+    int n = vertices.size();
+    //convert the polygon into dcel
+    Face<T>* face = new Face<T>(countPartition, partitionEdges[0]);
+    vector<Face<T>*> faces;
+    faces.push_back(face);
+    DCEL<T>* partitionPolygon = new DCEL<T>(partitionVertices, partitionEdges, faces);
+
+
+    // create new vertex list and edge list and update original polygon
+    if(partitionVertices.size()==n)  {
+        vertices.clear();
+        edges.clear();
+        isNotch.clear();
+    }
+    else  {
+        vector<Vertex<T>*> verticesNew;
+        vector<Edge<T>*> edgesNew;
+        vector<char> isNotchNew;
+        //start from the last vertex of decomposition to the first vertex of decomposition
+        int i = start+partitionVertices.size()-1;
+        while(i%n!=start%n)  {
+            verticesNew.push_back(vertices[i%n]);
+            edgesNew.push_back(edges[i%n]);
+            isNotchNew.push_back(isNotch[i%n]);
+            i=i%n;
+            i++;
+        }
+        verticesNew.push_back(vertices[start%n]); // first vertex of decomposition
+        //the new edge joins the two ends, the angles everywhere else are unchanged
+        int m = verticesNew.size();
+        isNotchNew[0] = isReflex(verticesNew[m-1], verticesNew[0], verticesNew[1%m]);
+        isNotchNew.push_back(isReflex(verticesNew[m-2], verticesNew[m-1], verticesNew[0]));
+        Edge<T>* edge = new Edge<T>(verticesNew.back());
+        // partitionVertices.back()->setIncidentEdge(edge);
+        edge->setPrevEdge(edgesNew.back());
+        edge->setNextEdge(edgesNew[0]);
+        edgesNew[0]->setPrevEdge(edge);
+        edgesNew.back()->setNextEdge(edge);
+        edgesNew.push_back(edge);
+
+        vertices = verticesNew;
+        edges = edgesNew;
+        isNotch = isNotchNew;
+    }
+    return partitionPolygon;
+}
+
+/**
+ * \brief Cuts off the partition of a given size at start again, as returnPartitionAndUpdatePolygon found it in the same polygon
+ * \brief O(n) time and space where n is the number of vertices of the polygon, without any of the search
+ * \param &vertices A vector of vertices holding the polygon
+ * \param &edges A vector of edges holding the connections between the vertices
+ * \param &isNotch notch flags of vertices, kept in step with them
+ * \param start index of the first vertex of the partition in the polygon
+ * \param size number of vertices of the partition
+ * \param edgeCount number of edges of the partition, n-1 when a partition of every vertex was left without its closing edge
+ * \param countPartition # of the current Partition
+ * \return Pointer to the DCEL object of the partition
+ */
+
+DCEL<T>* cutPartition(vector<Vertex<T>*> &vertices, vector<Edge<T>*> &edges, vector<char> &isNotch, int start, int size, int edgeCount, int countPartition)  {
+    int n = vertices.size();
+    vector<Vertex<T>*> partitionVertices;
+    vector<Edge<T>*> partitionEdges;
+    for(int k = 0; k<size; k++)
+        partitionVertices.push_back(vertices[(start+k)%n]);
+    //the edges along the polygon, every one of them for a partition of every vertex unless it was left open
+    int alongPolygon = size<n ? size-1 : edgeCount;
+    for(int k = 0; k<alongPolygon; k++)
+        partitionEdges.push_back(edges[(start+k)%n]);
+    //the diagonal closing the partition, linked as the search links it
+    if(size<n)  {
+        Edge<T>* edge = new Edge<T>(partitionVertices.back());
+        edge->setNextEdge(partitionEdges[0]);
+        edge->setPrevEdge(partitionEdges.back());
+        partitionEdges[0]->setPrevEdge(edge);
+        partitionEdges.back()->setNextEdge(edge);
+        partitionEdges.push_back(edge);
+    }
+    return splitOffPartition(vertices, edges, isNotch, start, partitionVertices, partitionEdges, countPartition);
+}
+
 /**
  * \brief Returns a convex partition and updates the original polygon to the relative complement of this partition
  * \brief Worst Case Time Complexity- O(n^2) where n is the number of vertices in the original polygon
  * \brief Worst Case Space Complexity- O(n) where n is the number of vertices in the original polygon
  * \param  &vertices A vector of vertices holding the input polygon
  * \param &edges A vector of edges holding the connections between the vertices
+ * \param &isNotch notch flags of vertices (see notchFlags), kept in step with them: cutting the partition off only
+ * changes the angles at the two ends of the new edge, so only those two are recomputed
  * \param start index of the starting vertex in the input polygon
  * \param countPartition # of the current Partition
- * \return Pointer to the DCEL object of the partition
+ * \return Pointer to the DCEL object of the partition, with at most maxFaceVertices vertices when that is set
  */
 
-DCEL<T>* returnPartitionAndUpdatePolygon(vector<Vertex<T>*> &vertices, vector<Edge<T>*> &edges, int start, int countPartition)  {
+DCEL<T>* returnPartitionAndUpdatePolygon(vector<Vertex<T>*> &vertices, vector<Edge<T>*> &edges, vector<char> &isNotch, int start, int countPartition)  {
     if(vertices.size()<=2)
         return NULL;
-    DCEL<T>* partitionPolygon; //ans
+    TraceSpan span("partition", "start", start);
+    //times a notch inside the provisional polygon made the scan drop its last vertex and start over
+    int restarts = 0;
 
     int n = vertices.size();
     vector<Vertex<T>*> partitionVertices;
@@ -514,13 +969,16 @@ DCEL<T>* returnPartitionAndUpdatePolygon(vector<Vertex<T>*> &vertices, vector<Ed
     // fout<<"here 151\n";
     int i = (start+1)%n;
     //add provisional vertices
-    while(!isReflex(vertices[((i-1)%n+n)%n], vertices[(i)%n], vertices[(i+1)%n]) && !isReflex(vertices[(i)%n], vertices[(i+1)%n], vertices[(start)%n]) && !isReflex(vertices[(i+1)%n], vertices[start%n], vertices[(start+1)%n]))  {
+    while(!isNotch[i%n] && !isReflex(vertices[(i)%n], vertices[(i+1)%n], vertices[(start)%n]) && !isReflex(vertices[(i+1)%n], vertices[start%n], vertices[(start+1)%n]))  {
         if((i+1)%n==start%n)  {
             partitionEdges.push_back(edges[(i)%n]);
             // partitionEdges[0]->setPrevEdge(partitionEdges.back());
             // partitionEdges.back()->setNextEdge(partitionEdges[0]);
             break;
         }
+        //the face is full, the chain is closed here as if the next vertex broke convexity
+        if(maxFaceVertices && (int)partitionVertices.size()>=maxFaceVertices)
+            break;
         partitionVertices.push_back(vertices[(i+1)%n]);
         isRemovedFromMainPolygon.insert(vertices[(i+1)%n]->getId());
         partitionEdges.push_back(edges[(i)%n]);
@@ -557,10 +1015,11 @@ DCEL<T>* returnPartitionAndUpdatePolygon(vector<Vertex<T>*> &vertices, vector<Ed
     bool isFirst = true;
     for(int i = 0; i<n&&partitionVertices.size()>2; i++)  {
         //point in P-L and L has more than 2 points
-        if(isRemovedFromMainPolygon.find(vertices[i]->getId())==isRemovedFromMainPolygon.end())  { //not removed
+        //convex vertices are skipped on their flag, before looking their id up
+        if(isNotch[i] && isRemovedFromMainPolygon.find(vertices[i]->getId())==isRemovedFromMainPolygon.end())  { //not removed
             //if some point of P-L is which is a notch is inside the rectangle of the polygon
             //and is inside then polygon, then
-            if(isReflex(vertices[((i-1)%n+n)%n], vertices[(i)%n], vertices[(i+1)%n]) && isInsidePolygon(rectangleVertices,rectangleEdges,vertices[i]) && isInsidePolygon(partitionVertices,partitionEdges,vertices[i]))  {
+            if(isInsidePolygon(rectangleVertices,rectangleEdges,vertices[i]) && isInsidePolygon(partitionVertices,partitionEdges,vertices[i]))  {
                 // fout<<"removing "<<partitionVertices.back()->getId()<<" because of "<<vertices[i]->getId()<<"\n";
                 //put the vertex back in the main polygon
                 isRemovedFromMainPolygon.erase(partitionVertices.back()->getId());
@@ -606,69 +1065,38 @@ DCEL<T>* returnPartitionAndUpdatePolygon(vector<Vertex<T>*> &vertices, vector<Ed
                 // partitionEdges[0]->setPrevEdge(partitionEdges.back());
 
                 rectangleCoordinates=getRectangleAroundPolygon(partitionVertices);
+                freeDCEL(rectangle);
                 rectangle = makeRectangle(rectangleCoordinates.first,rectangleCoordinates.second);
 
                 rectangleVertices = rectangle->getVertices();
                 rectangleEdges = rectangle->getEdges();
 
+                restarts++;
                 i=-1;
             }
         }
     }
     
+    freeDCEL(rectangle);
+    span.setArgument("restarts", restarts);
+    span.setArgument("vertices", partitionVertices.size());
     // fout<<"here 196\n";
     // printPolygon(partitionEdges[0]);
-    //convert the polygon into dcel
     if(partitionVertices.size()<=2)
         return NULL;
-    Face<T>* face = new Face<T>(countPartition, partitionEdges[0]);
-    vector<Face<T>*> faces;
-    faces.push_back(face);
-    partitionPolygon = new DCEL<T>(partitionVertices, partitionEdges, faces);
-
-
-    // create new vertex list and edge list and update original polygon
-    if(partitionVertices.size()==n)  {
-        vertices.clear();
-        edges.clear();
-    }
-    else  {
-        vector<Vertex<T>*> verticesNew;
-        vector<Edge<T>*> edgesNew;
-        //start from the last vertex of decomposition to the first vertex of decomposition
-        i = start+partitionVertices.size()-1;
-        while(i%n!=start%n)  {
-            verticesNew.push_back(vertices[i%n]);
-            edgesNew.push_back(edges[i%n]);
-            i=i%n;
-            i++;
-        }
-        verticesNew.push_back(vertices[start%n]); // first vertex of decomposition
-        Edge<T>* edge = new Edge<T>(verticesNew.back());
-        // partitionVertices.back()->setIncidentEdge(edge);
-        edge->setPrevEdge(edgesNew.back());
-        edge->setNextEdge(edgesNew[0]);
-        edgesNew[0]->setPrevEdge(edge);
-        edgesNew.back()->setNextEdge(edge);
-        edgesNew.push_back(edge);
-
-        vertices = verticesNew;
-        edges = edgesNew;
-    }
-    // fout<<"here 230\n";
-    //return dcel
-    return partitionPolygon;
-}  
+    return splitOffPartition(vertices, edges, isNotch, start, partitionVertices, partitionEdges, countPartition);
+}
 
 /**
  * \brief Merges the partition polygon with the polygon decomposition and checks if removing any common edges leads to a convex polygon. If yes,it removes that edge and returns the polygon decomposition.
  * \brief O(n) time (where n is the number of vertices), O(n) space(where n is the number of vertices) 
  * \param partitionPolygon Partition of polygon
  * \param polygonDecomposition Decomposition of a polygon
- * \return Pointer to the resulting merged DCEL object
+ * \return Pointer to the resulting merged DCEL object, a merge that would give a face more than maxFaceVertices vertices is not made
  */
 
 DCEL<T>* mergePartitionWithDecomposition(DCEL<T>* partitionPolygon, DCEL<T>* polygonDecomposition, int &countPartition)  {
+    TraceSpan span("merge", "partition", countPartition);
     //the first time the function is called
     if(!polygonDecomposition)
         return partitionPolygon;
@@ -696,6 +1124,11 @@ DCEL<T>* mergePartitionWithDecomposition(DCEL<T>* partitionPolygon, DCEL<T>* pol
     set<Edge<T>*> isEdgeMarkedForRemoval;
     //if a new face is to be added
     bool addNewFace=true;
+    //face the partition was merged into, a second face merged through another diagonal joins the same cycle
+    Face<T>* mergedFace=NULL;
+    set<Face<T>*> isFaceMarkedForRemoval;
+    //vertices of the cycle the partition is in, every merge through a diagonal adds the other face less the two ends
+    int mergedVertexCount=partitionVertices.size();
 
     //get all the pair of vertices that have an edge between them in the partition
     for(auto edge: partitionEdges)  {
@@ -723,8 +1156,12 @@ DCEL<T>* mergePartitionWithDecomposition(DCEL<T>* partitionPolygon, DCEL<T>* pol
             if(vertexPairs.find({edge->getNextEdge()->getOriginVertex(), edge->getOriginVertex()})!=vertexPairs.end()) {
                
                Edge<T>* partitionEdge=vertexPairs[{edge->getNextEdge()->getOriginVertex(), edge->getOriginVertex()}];
-               //if found a common diagonal check for reflex angles on the vertices
-                if(!isReflex(partitionEdge->getPrevEdge()->getOriginVertex(), partitionEdge->getOriginVertex(), edge->getNextEdge()->getNextEdge()->getOriginVertex())  && !isReflex(edge->getPrevEdge()->getOriginVertex(), edge->getOriginVertex(), partitionEdge->getNextEdge()->getNextEdge()->getOriginVertex()))  {
+               bool isJoined = face==mergedFace || isFaceMarkedForRemoval.count(face);
+               int joinedVertexCount = mergedVertexCount+(isJoined ? 0 : (int)edgeIterator.size())-2;
+               //if found a common diagonal check for reflex angles on the vertices, and that the face stays within the limit
+                if(!isReflex(partitionEdge->getPrevEdge()->getOriginVertex(), partitionEdge->getOriginVertex(), edge->getNextEdge()->getNextEdge()->getOriginVertex())  && !isReflex(edge->getPrevEdge()->getOriginVertex(), edge->getOriginVertex(), partitionEdge->getNextEdge()->getNextEdge()->getOriginVertex())
+                   && (!maxFaceVertices || joinedVertexCount<=maxFaceVertices))  {
+                    mergedVertexCount = joinedVertexCount;
 
                     //change the marker for face if necessary
                     if(face->getIncidentEdge()==edge || face->getIncidentEdge()==partitionEdge)
@@ -738,6 +1175,13 @@ DCEL<T>* mergePartitionWithDecomposition(DCEL<T>* partitionPolygon, DCEL<T>* pol
                     (edge->getNextEdge())->setPrevEdge(partitionEdge->getPrevEdge());
                     //no additional face is added(at most one new face is to be added)
                     addNewFace=false;
+                    //the partition already joined another face, the two faces are now a single cycle
+                    if(!mergedFace)
+                        mergedFace=face;
+                    else if(mergedFace!=face && !isFaceMarkedForRemoval.count(face))  {
+                        isFaceMarkedForRemoval.insert(face);
+                        countPartition--;
+                    }
                     //mark the pair of edges to not be added
                     isEdgeMarkedForRemoval.insert(edge);
                     isEdgeMarkedForRemoval.insert(partitionEdge);
@@ -780,7 +1224,10 @@ DCEL<T>* mergePartitionWithDecomposition(DCEL<T>* partitionPolygon, DCEL<T>* pol
     }
 
     //add face is new face is to be added
-    finalDecompositionFaces=decompositionFaces;
+    for(auto face: decompositionFaces)  {
+        if(isFaceMarkedForRemoval.find(face)==isFaceMarkedForRemoval.end())
+            finalDecompositionFaces.push_back(face);
+    }
     //there is only one face in the partition
     if(addNewFace)
         finalDecompositionFaces.push_back(partitionFaces[0]);
@@ -796,6 +1243,16 @@ DCEL<T>* mergePartitionWithDecomposition(DCEL<T>* partitionPolygon, DCEL<T>* pol
     DCEL<T>* finalDecomposition = new DCEL<T>(finalDecompositionVertices, finalDecompositionEdges, finalDecompositionFaces);
     if(!addNewFace)
         countPartition--;
+
+    //the removed diagonals, the faces merged away and both inputs are not referenced any more
+    for(auto edge: isEdgeMarkedForRemoval)
+        delete edge;
+    for(auto face: isFaceMarkedForRemoval)
+        delete face;
+    if(!addNewFace)
+        delete partitionFaces[0];
+    delete partitionPolygon;
+    delete polygonDecomposition;
     return finalDecomposition;
 }
 
@@ -862,19 +1319,68 @@ void printGraph(vector<Point> &vertexList, vector<vector<int>> &adjacencyMatrix)
     return;
 }
 
+/**
+ * @brief Prints a decomposition exactly as printGraph prints its adjacency matrix, without building the matrix
+ * @brief O(n log n) time and O(n) space where n is the number of vertices of the decomposition
+ * @param polygonDCEL decomposition to print
+ */
+
+void printDecompositionGraph(DCEL<T>* polygonDCEL)  {
+    vector<Vertex<T>*> vertices=polygonDCEL->getVertices();
+    map<Point,int> coordinateIndex;
+    for(int i = 0; i<vertices.size(); i++)
+        coordinateIndex[vertices[i]->getCoordinate()]=i;
+
+    //pairs as {row, column} below the diagonal, in the order printGraph walks the matrix
+    set<pair<int,int>> adjacentPairs;
+    for(auto face:polygonDCEL->getFaces())  {
+        Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            int from = coordinateIndex[edge->getOriginVertex()->getCoordinate()];
+            int to = coordinateIndex[edge->getNextEdge()->getOriginVertex()->getCoordinate()];
+            if(from!=to)
+                adjacentPairs.insert({max(from, to), min(from, to)});
+            edge=edge->getNextEdge();
+        }while(edge!=fixEdge);
+    }
+
+    fout<<"Coordinates are:\n";
+    for(auto vertex: vertices)  {
+        fout<<"("<<vertex->getCoordinate().first<<","<<vertex->getCoordinate().second<<")\n";
+    }
+    fout<<"Draw edges between the following pairs:\n";
+    for(auto &adjacentPair: adjacentPairs)  {
+        Point from = vertices[adjacentPair.first]->getCoordinate(), to = vertices[adjacentPair.second]->getCoordinate();
+        fout<<"("<<from.first<<","<<from.second<<")---";
+        fout<<"("<<to.first<<","<<to.second<<")\n";
+    }
+    fout<<"\n\n\n";
+    return;
+}
+
 // Declare this function outside
 // the main function
 
 /**
- * \brief Utility function to handle input/output files
+ * \brief Returns the number used in the input/output file names
  */
 
-void local(int i)
+string fileNumber(int i)
 {
     string s;
     if(i>9)
         s.push_back('0'+i/10);
     s.push_back('0'+i%10);
+    return s;
+}
+
+/**
+ * \brief Utility function to handle input/output files
+ */
+
+void local(int i)
+{
+    string s = fileNumber(i);
   // In case of online judges (like
   // codechef, codeforces etc) these
   // lines will be skipped. In other
@@ -894,10 +1400,7 @@ void local(int i)
 
 void localOut(int i)
 {
-    string s;
-    if(i>9)
-        s.push_back('0'+i/10);
-    s.push_back('0'+i%10);
+    string s = fileNumber(i);
   // In case of online judges (like
   // codechef, codeforces etc) these
   // lines will be skipped. In other
@@ -998,10 +1501,12 @@ void deepCopy(vector<Vertex<T>*> &vertices, vector<Edge<T>*> &edges,  vector<Ver
  */
 
 bool polygonCompare(DCEL<T>* polygon1, DCEL<T>* polygon2)  {
-    auto vertices1 = polygon1->getVertices()[0];
-    auto vertices2 = polygon2->getVertices()[0];
-    auto size1 = polygon2->getVertices().size();
-    auto size2 = polygon2->getVertices().size();
+    vector<Vertex<T>*> polygonVertices1 = polygon1->getVertices();
+    vector<Vertex<T>*> polygonVertices2 = polygon2->getVertices();
+    auto vertices1 = polygonVertices1[0];
+    auto vertices2 = polygonVertices2[0];
+    auto size1 = polygonVertices1.size();
+    auto size2 = polygonVertices2.size();
 
     if(size1!=size2)
         return false;
@@ -1026,158 +1531,2225 @@ bool polygonCompare(DCEL<T>* polygon1, DCEL<T>* polygon2)  {
 }
 
 /**
- * @brief program to convert a given "polygon" into a set of convex polygons without introducing additional vertices
- * @brief Worst Case Time Complexity- O(n^4) where n is the number of vertices in the original polygon
- * @brief Worst Case Space Complexity- O(n^2) where n is the number of vertices in the original polygon
+ * @brief Appends a vertex to a polygon ring, linking its edge after the current last edge and closing the ring back to the first edge
+ * @brief O(1) time and O(1) space
+ * @param vertices vertices of the ring, in clockwise order
+ * @param edges edges of the ring, edges[i] starts at vertices[i]
+ * @param id unique identifier of the new vertex
+ * @param coordinate coordinate of the new vertex
  */
-// program to convert a given "polygon" into a set of convex polygons without introducing additional vertices
-int main()  {
-    for(int i = 1; i<=1; i++)  {
-        local(i);
 
-        auto start = chrono::steady_clock::now();
-        // input format
-        /*
-        First line contains an integer n representing the number of vertices in the polygon.
-        The next n lines contains vertices(3 things, i.e vertex_id x_coord y_coord)
-        connected in a clockwise fashion. Coordinate and id both should be unique
-        Eg:
-        5
-        A 0 0
-        B 0 6
-        C 3 3
-        D 6 6
-        E 6 0
+void appendPolygonVertex(vector<Vertex<T>*> &vertices, vector<Edge<T>*> &edges, string id, Point coordinate)  {
+    Edge<T>* edge = new Edge<T>();
+    Vertex<T>* vertex = new Vertex<T>(id, coordinate, edge);
+    edge->setOriginVertex(vertex);
+    vertices.push_back(vertex);
+    edges.push_back(edge);
+
+    int i = edges.size()-1;
+    //at least 2 vertices are there, so we can start making edge connections
+    // not making the graph "directed" by splitting edges, since not required
+    if(i>=1)  {
+        edges[i-1]->setNextEdge(edges[i]);
+        edges[i]->setPrevEdge(edges[i-1]);
+    }
+    edges[i]->setNextEdge(edges[0]);
+    edges[0]->setPrevEdge(edges[i]);
+}
 
-        The edges are A-B-C-D-E-A
-        */
-        int numberOfVertices;
-        fin>>numberOfVertices;
-        vector<Vertex<T>*> vertices, verticesConst;
-        vector<Edge<T>*> edges, edgesConst;
-        //take input and store all the vertices and edges
-        //Theta(n)
+/**
+ * @brief Hash of the state a start has reached- what is left of the polygon, read in the order it is stored in, and where
+ * the start scans it from. The partitions cut off from then on depend on nothing else.
+ * @brief O(r) time where r is the number of vertices left, O(1) space
+ * @param vertices what is left of the polygon
+ * @param vertexIndex position of every vertex id in the original polygon
+ * @param start start offset, taken modulo the vertices left
+ * @return two polynomial hashes of the vertex positions, with the size and the scan position folded in
+ */
 
-        for(int i = 0; i<numberOfVertices; i++)  {
-            string id;
-            pair<T,T> coordinate;
-            // fin>>id>>coordinate.first>>coordinate.second;
-            // id = "id"+to_string(i);
-            fin>>id>>coordinate.first>>coordinate.second;
-            // fout<<"Hello World\n";
-            Edge<T>* edge = new Edge<T>();
-            Vertex<T>* vertex = new Vertex<T>(id, coordinate, edge);
-            edge->setOriginVertex(vertex);
-            vertices.push_back(vertex);
-            edges.push_back(edge);
+pair<uint64_t,uint64_t> remainderKey(vector<Vertex<T>*> &vertices, unordered_map<string,int> &vertexIndex, int start)  {
+    int r = vertices.size();
+    uint64_t hash1 = r*1000003ULL+start%r, hash2 = (r*0x100000001b3ULL)^(start%r);
+    for(int k = 0; k<r; k++)  {
+        uint64_t index = vertexIndex[vertices[k]->getId()]+1;
+        hash1 = hash1*1000003+index;
+        hash2 = (hash2*0x100000001b3ULL)^(index*0x9e3779b97f4a7c15ULL);
+    }
+    return {hash1, hash2};
+}
 
-            Edge<T>* edgeConst = new Edge<T>();
-            Vertex<T>* vertexConst = new Vertex<T>(id, coordinate, edgeConst);
-            edgeConst->setOriginVertex(vertexConst);
-            verticesConst.push_back(vertexConst);
-            edgesConst.push_back(edgeConst);
+/**
+ * @brief Keeps a decomposition if it is among the best seen so far, frees it or the one it pushes out otherwise
+ * @brief O(k) time where k is the number of decompositions kept, plus freeing the one dropped
+ * @param retained kept decompositions as (count of pieces, start offset, decomposition), best first
+ * @param keep how many decompositions to keep
+ * @param countPartition count of pieces of the new decomposition
+ * @param start start offset the new decomposition came from, ties go to the earliest start
+ * @param polygonDecomposition the new decomposition
+ * \return none
+ */
 
-            //at least 2 vertices are there, so we can start making edge connections
-            // not making the graph "directed" by splitting edges, since not required
-            if(i>=1)  {
-                edges[i-1]->setNextEdge(edges[i]);
-                edges[i]->setPrevEdge(edges[i-1]);
+void retainDecomposition(vector<tuple<int,int,DCEL<T>*>> &retained, int keep, int countPartition, int start, DCEL<T>* polygonDecomposition)  {
+    tuple<int,int,DCEL<T>*> entry = {countPartition, start, polygonDecomposition};
+    auto position = retained.begin();
+    while(position!=retained.end() && make_pair(get<0>(*position), get<1>(*position))<make_pair(countPartition, start))
+        position++;
+    retained.insert(position, entry);
+    if(retained.size()>keep)  {
+        freeDCEL(get<2>(retained.back()));
+        retained.pop_back();
+    }
+}
 
-                edgesConst[i-1]->setNextEdge(edgesConst[i]);
-                edgesConst[i]->setPrevEdge(edgesConst[i-1]);
+/**
+ * @brief Builds the decomposition of a polygon cut along non-crossing diagonals
+ * @brief O((n + d) log n) time and O(n + d) space where n is the number of vertices and d the number of diagonals,
+ * O(n) time without diagonals (convex polygons), the single face being linked directly
+ *
+ * Every face is walked clockwise: arriving at v from u, the walk leaves along the neighbour of v that comes last
+ * before u in ring order from v. Boundary edges have no twin, the two sides of a diagonal are twins, the faces are
+ * numbered from 1 and every vertex is shared by the faces around it.
+ * @param verticesConst vertices of the polygon in clockwise order, copied
+ * @param diagonals pairs of vertex positions, no two crossing
+ * @return Pointer to the DCEL of the decomposition
+ */
 
-            }
-            if(i==numberOfVertices-1)  {
-                edges[i]->setNextEdge(edges[0]);
-                edges[0]->setPrevEdge(edges[i]);
+DCEL<T>* decompositionFromDiagonals(vector<Vertex<T>*> &verticesConst, vector<pair<int,int>> &diagonals)  {
+    int n = verticesConst.size();
+    vector<Vertex<T>*> vertices;
+    for(auto vertex: verticesConst)
+        vertices.push_back(new Vertex<T>(vertex->getId(), vertex->getCoordinate()));
+    if(diagonals.empty())  {
+        //the whole ring is the face, its edges are the boundary in order
+        vector<Edge<T>*> edges;
+        for(int i = 0; i<n; i++)  {
+            edges.push_back(new Edge<T>(vertices[i]));
+            vertices[i]->setIncidentEdge(edges[i]);
+        }
+        Face<T>* face = new Face<T>(1, edges[0]);
+        for(int i = 0; i<n; i++)  {
+            edges[i]->setNextEdge(edges[(i+1)%n]);
+            edges[(i+1)%n]->setPrevEdge(edges[i]);
+            edges[i]->setLeftFace(face);
+        }
+        return new DCEL<T>(vertices, edges, {face});
+    }
+    //neighbours of every vertex by clockwise distance along the ring
+    vector<vector<int>> neighbours(n);
+    for(int i = 0; i<n; i++)  {
+        neighbours[i].push_back((i+1)%n);
+        neighbours[(i+1)%n].push_back(i);
+    }
+    for(auto &diagonal: diagonals)  {
+        neighbours[diagonal.first].push_back(diagonal.second);
+        neighbours[diagonal.second].push_back(diagonal.first);
+    }
+    for(int i = 0; i<n; i++)
+        sort(neighbours[i].begin(), neighbours[i].end(), [&](int a, int b)  { return (a-i+n)%n<(b-i+n)%n; });
 
-                edgesConst[i]->setNextEdge(edgesConst[0]);
-                edgesConst[0]->setPrevEdge(edgesConst[i]);
-            }
+    map<pair<int,int>, Edge<T>*> halfEdges;
+    vector<Edge<T>*> edges;
+    vector<Face<T>*> faces;
+    auto halfEdge = [&](int u, int v)  {
+        Edge<T>* &edge = halfEdges[{u, v}];
+        if(!edge)  {
+            edge = new Edge<T>(vertices[u]);
+            edges.push_back(edge);
         }
-        // saving the polygon in a dcel, and now operating on the vectors from above
-        Face<T>* face = new Face<T>(1, edgesConst[0]);
-        vector<Face<T>*> faces;
+        return edge;
+    };
+    //every face has a boundary edge or a diagonal side not walked yet, starting from each half-edge once finds them all
+    vector<pair<int,int>> starts;
+    for(int i = 0; i<n; i++)
+        starts.push_back({i, (i+1)%n});
+    for(auto &diagonal: diagonals)  {
+        starts.push_back(diagonal);
+        starts.push_back({diagonal.second, diagonal.first});
+    }
+    set<pair<int,int>> isWalked;
+    for(auto &first: starts)  {
+        if(isWalked.count(first))
+            continue;
+        Face<T>* face = new Face<T>(faces.size()+1, halfEdge(first.first, first.second));
         faces.push_back(face);
-        DCEL<T>* originalPolygon = new DCEL<T>(verticesConst, edgesConst, faces);
+        pair<int,int> current = first;
+        do  {
+            isWalked.insert(current);
+            int u = current.first, v = current.second;
+            vector<int> &around = neighbours[v];
+            int w = *(lower_bound(around.begin(), around.end(), u, [&](int a, int b)  { return (a-v+n)%n<(b-v+n)%n; })-1);
+            Edge<T>* edge = halfEdge(u, v), *next = halfEdge(v, w);
+            edge->setNextEdge(next);
+            next->setPrevEdge(edge);
+            edge->setLeftFace(face);
+            current = {v, w};
+        }while(current!=first);
+    }
+    for(auto &diagonal: diagonals)  {
+        halfEdges[diagonal]->setTwinEdge(halfEdges[{diagonal.second, diagonal.first}]);
+        halfEdges[{diagonal.second, diagonal.first}]->setTwinEdge(halfEdges[diagonal]);
+    }
+    for(int i = 0; i<n; i++)
+        vertices[i]->setIncidentEdge(halfEdges[{i, (i+1)%n}]);
+    return new DCEL<T>(vertices, edges, faces);
+}
 
-        DCEL<T>* polygonDecomposition = NULL;
-        set<DCEL<T>*> minimalPolygonDecomposition;
+/**
+ * @brief Checks whether the segment ring[a]-ring[b] splits the angle at ring[a] into two angles that are not reflex
+ * @brief O(1) time and O(1) space
+ */
 
-        DCEL<T>* partitionPolygon = NULL;
-        DCEL<T>* firstPolygonPartition = NULL;
-        bool isFirstPolygonPartition = true;
+bool isResolvedBy(vector<Vertex<T>*> &vertices, vector<int> &ring, int a, int b)  {
+    int m = ring.size();
+    Vertex<T>* vertexA = vertices[ring[a]], *vertexB = vertices[ring[b]];
+    return !isReflex(vertices[ring[(a+m-1)%m]], vertexA, vertexB) && !isReflex(vertexB, vertexA, vertices[ring[(a+1)%m]]);
+}
 
-        fout<<"Original Polygon:\n";
-        printPolygon(edgesConst[0]);
+/**
+ * @brief Checks whether ring[a]-ring[b] is a diagonal of the ring, i.e. runs inside it and touches it only at its ends
+ * @brief O(m) time where m is the size of the ring, O(1) space
+ * @param vertices vertices of the polygon
+ * @param ring positions in vertices of a clockwise sub-polygon
+ * @param a position in ring of one end
+ * @param b position in ring of the other end
+ * @return true or false
+ */
 
-        int minimalCountPartition = inf;
-        int s = 0;
-        // numberOfVertices=1;
-        while(s<numberOfVertices)  {
-            int countPartition = 1;
-            do  {
-                for(int i=0+s;i<vertices.size()+s;i++){
-                    partitionPolygon = returnPartitionAndUpdatePolygon(vertices, edges, i, countPartition);
-                    if(partitionPolygon)
+bool isDiagonal(vector<Vertex<T>*> &vertices, vector<int> &ring, int a, int b)  {
+    int m = ring.size();
+    if(a==b || (a+1)%m==b || (b+1)%m==a)
+        return false;
+    //it leaves each end into the polygon: for a convex end neither split angle is reflex, for a notch not both
+    for(int end = 0; end<2; end++)  {
+        int from = end==0 ? a : b, to = end==0 ? b : a;
+        Vertex<T>* previous = vertices[ring[(from+m-1)%m]], *vertex = vertices[ring[from]], *next = vertices[ring[(from+1)%m]];
+        bool isFirstReflex = isReflex(previous, vertex, vertices[ring[to]]), isSecondReflex = isReflex(vertices[ring[to]], vertex, next);
+        if(isReflex(previous, vertex, next) ? isFirstReflex && isSecondReflex : isFirstReflex || isSecondReflex)
+            return false;
+    }
+    line diagonal = {vertices[ring[a]]->getCoordinate(), vertices[ring[b]]->getCoordinate()};
+    for(int k = 0; k<m; k++)
+        if(segmentsIntersect(diagonal, {vertices[ring[k]]->getCoordinate(), vertices[ring[(k+1)%m]]->getCoordinate()}))
+            return false;
+    return true;
+}
+
+/**
+ * @brief Finds every vertex a single diagonal from notch ring[a] can go to so that the notch is resolved
+ * @brief O(m + k m) time where k is the number of vertices inside the reflex angle, O(k) space
+ * @param vertices vertices of the polygon
+ * @param ring positions in vertices of a clockwise sub-polygon
+ * @param a position in ring of the notch
+ * @return positions in ring of the other ends, in ring order
+ */
+
+vector<int> resolvingVertices(vector<Vertex<T>*> &vertices, vector<int> &ring, int a)  {
+    vector<int> ends;
+    for(int b = 0; b<ring.size(); b++)
+        if(b!=a && isResolvedBy(vertices, ring, a, b) && isDiagonal(vertices, ring, a, b))
+            ends.push_back(b);
+    return ends;
+}
+
+/**
+ * @brief Returns the positions of the ring from a to b, both included, going clockwise
+ */
+
+vector<int> ringArc(vector<int> &ring, int a, int b)  {
+    vector<int> arc;
+    for(int i = a; ; i = (i+1)%ring.size())  {
+        arc.push_back(ring[i]);
+        if(i==b)
+            break;
+    }
+    return arc;
+}
+
+/**
+ * @brief Checks whether position c lies strictly inside the clockwise arc from a to b
+ */
+
+bool isStrictlyBetween(int a, int b, int c, int m)  {
+    return c!=a && c!=b && (c-a+m)%m<(b-a+m)%m;
+}
+
+/**
+ * @brief Decomposes a polygon with at most two notches directly, into the fewest convex pieces possible with diagonals
+ * @brief O(n) time for convex polygons, O(n + k n) with one or two notches where k is the number of vertices inside their reflex angles, O(n) space
+ *
+ * A notch stays reflex unless a diagonal ends at it, and a notch whose reflex angle holds no vertex it can see needs two.
+ * - no notch: the polygon itself
+ * - one notch: 2 pieces if one diagonal resolves it. Otherwise the extension of an edge at the notch cuts the polygon into
+ *   two convex parts and hits an edge whose ends both see the notch, the two diagonals to them give 3 pieces
+ * - two notches: 2 pieces if the diagonal joining them resolves both (2 pieces are one diagonal, which must end at both
+ *   notches). 3 pieces are two diagonals, either one resolving each notch without crossing the other, or the diagonal joining
+ *   the notches resolving one of them and a second one resolving the other inside the piece still holding it
+ * Two notches needing 4 or more pieces are left to the general search.
+ * @param verticesConst vertices of the polygon in clockwise order, left untouched
+ * @param notchCount set to the number of notches, counted up to 3
+ * @return Pointer to the DCEL of the decomposition, NULL when the polygon is left to the general search
+ */
+
+DCEL<T>* decomposeFewNotches(vector<Vertex<T>*> &verticesConst, int &notchCount)  {
+    int n = verticesConst.size();
+    vector<int> notches;
+    for(int i = 0; i<n && notches.size()<=2; i++)
+        if(isReflex(verticesConst[(i+n-1)%n], verticesConst[i], verticesConst[(i+1)%n]))
+            notches.push_back(i);
+    notchCount = notches.size();
+    if(n<3 || notches.size()>2)
+        return NULL;
+
+    vector<int> ring(n);
+    iota(ring.begin(), ring.end(), 0);
+    vector<pair<int,int>> diagonals;
+    if(notches.size()==1)  {
+        int a = notches[0];
+        vector<int> ends = resolvingVertices(verticesConst, ring, a);
+        if(!ends.empty())
+            diagonals.push_back({a, ends[0]});
+        else  {
+            //extend the edge entering the notch to the nearest edge it hits
+            Point from = verticesConst[(a+n-1)%n]->getCoordinate(), notch = verticesConst[a]->getCoordinate();
+            double dx = (double)notch.first-from.first, dy = (double)notch.second-from.second, nearest = DBL_MAX;
+            int hit = -1;
+            for(int k = 0; k<n; k++)  {
+                if(k==a || (k+1)%n==a)
+                    continue;
+                Point p = verticesConst[k]->getCoordinate(), q = verticesConst[(k+1)%n]->getCoordinate();
+                double ex = (double)q.first-p.first, ey = (double)q.second-p.second, denominator = dx*ey-dy*ex;
+                if(denominator==0)
+                    continue;
+                double px = (double)p.first-notch.first, py = (double)p.second-notch.second;
+                double t = (px*ey-py*ex)/denominator, u = (px*dy-py*dx)/denominator;
+                if(t>0 && u>=0 && u<=1 && t<nearest)  {
+                    nearest = t;
+                    hit = k;
+                }
+            }
+            if(hit<0)
+                return NULL;
+            for(int end: {hit, (hit+1)%n})
+                if(isDiagonal(verticesConst, ring, a, end))
+                    diagonals.push_back({a, end});
+        }
+    }
+    else if(notches.size()==2)  {
+        int u = notches[0], v = notches[1];
+        bool isJoined = isDiagonal(verticesConst, ring, u, v);
+        if(isJoined && isResolvedBy(verticesConst, ring, u, v) && isResolvedBy(verticesConst, ring, v, u))
+            diagonals.push_back({u, v});
+        else  {
+            vector<int> endsU = resolvingVertices(verticesConst, ring, u), endsV = resolvingVertices(verticesConst, ring, v);
+            for(int x: endsU)  {
+                for(int y: endsV)  {
+                    //diagonals sharing an end never cross, the others cross when their ends interleave
+                    bool isCrossing = x!=y && x!=v && y!=u && isStrictlyBetween(u, x, v, n)!=isStrictlyBetween(u, x, y, n);
+                    if(!isCrossing)  {
+                        diagonals = {{u, x}, {v, y}};
                         break;
+                    }
+                }
+                if(!diagonals.empty())
+                    break;
+            }
+            //the diagonal between the notches resolves one of them, the other is resolved inside its reflex piece
+            for(int k = 0; k<2 && diagonals.empty() && isJoined; k++)  {
+                int resolved = k==0 ? v : u, other = k==0 ? u : v;
+                if(!isResolvedBy(verticesConst, ring, resolved, other))
+                    continue;
+                for(int side = 0; side<2 && diagonals.empty(); side++)  {
+                    vector<int> piece = side==0 ? ringArc(ring, other, resolved) : ringArc(ring, resolved, other);
+                    int position = side==0 ? 0 : piece.size()-1;
+                    int m = piece.size();
+                    if(!isReflex(verticesConst[piece[(position+m-1)%m]], verticesConst[other], verticesConst[piece[(position+1)%m]]))
+                        continue;
+                    vector<int> ends = resolvingVertices(verticesConst, piece, position);
+                    if(!ends.empty())
+                        diagonals = {{u, v}, {other, piece[ends[0]]}};
+                }
+            }
+            if(diagonals.empty())
+                return NULL;
+        }
+    }
+
+    DCEL<T>* decomposition = decompositionFromDiagonals(verticesConst, diagonals);
+    //every construction above is convex in exact arithmetic, a face left reflex by rounding sends the polygon to the general search
+    for(auto face: decomposition->getFaces())  {
+        Edge<T>* edge = face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            if(isReflex(edge->getPrevEdge()->getOriginVertex(), edge->getOriginVertex(), edge->getNextEdge()->getOriginVertex()))  {
+                freeDCEL(decomposition);
+                return NULL;
+            }
+            edge = edge->getNextEdge();
+        }while(edge!=fixEdge);
+    }
+    return decomposition;
+}
+
+/**
+ * @struct ExactState
+ * @brief Best decompositions of the sub-polygon cut off by one diagonal, for the exact engine
+ *
+ * weight is the fewest diagonals inside the sub-polygon i..k. pairs holds, for the decompositions reaching it, the
+ * narrowest ends (a, b) of the piece resting on i-k: a next to i and b next to k, a rising while b falls along the list.
+ */
+
+struct ExactState  {
+    bool isVisible = true;
+    //unreached, and still larger than any sum of two unreached weights
+    int weight = INT_MAX/4;
+    list<pair<int,int>> pairs;
+};
+
+/**
+ * @brief Decomposes a polygon into the fewest convex pieces possible with diagonals, by the dynamic program of Keil and Snoeyink
+ * @brief O(n r^2 k) time for the program where r is the number of notches and k bounds the length of the pair lists
+ * (a few entries in practice), plus O(n^2 r) to check the diagonals with a notch at one end; O(n r) space
+ *
+ * Only sub-polygons cut off by a diagonal with a notch at one end matter (the others are convex), so the states are kept in
+ * one row of n per notch. Vertex 0 of the anticlockwise ring is treated as a notch, as the whole polygon is the
+ * sub-polygon 0..n-1. Straight angles are dropped first, the program relies on strict turns, and end up on the sides of
+ * the pieces. The minimum is guaranteed when no segment between two other vertices runs through a vertex. Otherwise a
+ * piece with a straight angle there is only reachable through that segment, which is not a diagonal, and the result may
+ * have a piece more than necessary; it is still a valid convex decomposition.
+ * @param verticesConst vertices of the polygon in clockwise order, left untouched
+ * @param notchLimit largest number of notches worth the program, larger polygons return NULL at once
+ * @param notchCount set to the number of notches
+ * @return Pointer to the DCEL of the decomposition, NULL over the limit or when the program finds no decomposition
+ */
+
+DCEL<T>* decomposeExact(vector<Vertex<T>*> &verticesConst, int notchLimit, int &notchCount)  {
+    vector<Point> coordinates;
+    for(auto vertex: verticesConst)
+        coordinates.push_back(vertex->getCoordinate());
+    vector<int> kept = removeCollinearVertices(coordinates);
+    vector<Vertex<T>*> ring;
+    for(int i: kept)
+        ring.push_back(verticesConst[i]);
+    int n = ring.size();
+    //the program runs on the anticlockwise ring, position i is ring[n-1-i]
+    auto vertexAt = [&](int i)  { return ring[n-1-i]; };
+    //a right turn a -> b -> c, a notch of an anticlockwise ring, is a left turn of the clockwise one
+    auto isRightTurn = [&](int a, int b, int c)  { return isReflex(vertexAt(c), vertexAt(b), vertexAt(a)); };
+    vector<char> isConvex(n, 1);
+    vector<int> notches;
+    notchCount = 0;
+    for(int i = 0; i<n; i++)  {
+        notchCount += isRightTurn((i+n-1)%n, i, (i+1)%n);
+        isConvex[i] = isRightTurn((i+1)%n, i, (i+n-1)%n);
+    }
+    if(n<3 || notchCount>notchLimit)
+        return NULL;
+    vector<pair<int,int>> diagonals;
+    if(notchCount==0)
+        return decompositionFromDiagonals(verticesConst, diagonals);
+    isConvex[0] = 0;
+    for(int i = 0; i<n; i++)
+        if(!isConvex[i])
+            notches.push_back(i);
+
+    //state of i..k is kept in the row of i when i is a notch and in the row of k otherwise
+    vector<int> row(n, -1);
+    for(int r = 0; r<notches.size(); r++)
+        row[notches[r]] = r;
+    vector<vector<ExactState>> states(notches.size(), vector<ExactState>(n));
+    auto state = [&](int i, int k) -> ExactState*  {
+        if(row[i]>=0)
+            return &states[row[i]][k];
+        if(row[k]>=0)
+            return &states[row[k]][i];
+        return NULL;
+    };
+    vector<int> clockwise(n);
+    iota(clockwise.begin(), clockwise.end(), 0);
+    for(int i = 0; i<n; i++)  {
+        for(int k = i+1; k<n; k++)  {
+            ExactState* current = state(i, k);
+            if(!current)
+                continue;
+            if(k==i+1)
+                current->weight = 0;
+            else if(!(i==0 && k==n-1))
+                current->isVisible = isDiagonal(ring, clockwise, n-1-i, n-1-k);
+        }
+    }
+    for(int i = 0; i+2<n; i++)  {
+        ExactState* current = state(i, i+2);
+        if(current && current->isVisible)  {
+            current->weight = 0;
+            current->pairs.push_back({i+1, i+1});
+        }
+    }
+
+    //keeps (a, b) for i..k with w diagonals if it is as good as the best so far and not dominated by a narrower pair
+    auto update = [&](int i, int k, int w, int a, int b)  {
+        ExactState* current = state(i, k);
+        if(w>current->weight)
+            return;
+        if(w<current->weight)  {
+            current->pairs.clear();
+            current->weight = w;
+        }
+        else  {
+            if(!current->pairs.empty() && a<=current->pairs.front().first)
+                return;
+            while(!current->pairs.empty() && current->pairs.front().second>=b)
+                current->pairs.pop_front();
+        }
+        current->pairs.push_front({a, b});
+    };
+    //the piece on i-k has the edge i-j, j-k the side of a sub-polygon; i is a notch
+    auto typeA = [&](int i, int j, int k)  {
+        ExactState* left = state(i, j);
+        if(!left->isVisible)
+            return;
+        int top = j, w = left->weight;
+        if(k-j>1)  {
+            ExactState* right = state(j, k);
+            if(!right || !right->isVisible)
+                return;
+            w += right->weight+1;
+        }
+        if(j-i>1)  {
+            list<pair<int,int>> &pairs = left->pairs;
+            auto last = pairs.end();
+            for(auto it = pairs.end(); it!=pairs.begin(); )  {
+                --it;
+                if(isRightTurn(it->second, j, k))
+                    break;
+                last = it;
+            }
+            if(last==pairs.end() || isRightTurn(k, i, last->first))
+                w++;
+            else
+                top = last->first;
+        }
+        update(i, k, w, top, j);
+    };
+    //mirror image of typeA, k is a notch
+    auto typeB = [&](int i, int j, int k)  {
+        ExactState* right = state(j, k);
+        if(!right->isVisible)
+            return;
+        int top = j, w = right->weight;
+        if(j-i>1)  {
+            ExactState* left = state(i, j);
+            if(!left || !left->isVisible)
+                return;
+            w += left->weight+1;
+        }
+        if(k-j>1)  {
+            list<pair<int,int>> &pairs = right->pairs;
+            auto it = pairs.begin();
+            if(!pairs.empty() && !isRightTurn(i, j, it->first))  {
+                auto last = it;
+                for(; it!=pairs.end() && !isRightTurn(i, j, it->first); ++it)
+                    last = it;
+                if(isRightTurn(last->second, k, i))
+                    w++;
+                else
+                    top = last->second;
+            }
+            else
+                w++;
+        }
+        update(i, k, w, j, top);
+    };
+
+    for(int gap = 3; gap<n; gap++)  {
+        for(int i: notches)  {
+            int k = i+gap;
+            if(k>=n || !state(i, k)->isVisible)
+                continue;
+            //the pair lists rely on j rising; a convex j in between only has a state when k is a notch too
+            if(!isConvex[k])  {
+                for(int j = i+1; j<k; j++)
+                    typeA(i, j, k);
+            }
+            else  {
+                for(int j: notches)
+                    if(j>i && j<k-1)
+                        typeA(i, j, k);
+                typeA(i, k-1, k);
+            }
+        }
+        for(int k: notches)  {
+            int i = k-gap;
+            if(i<0 || !isConvex[i] || !state(i, k)->isVisible)
+                continue;
+            typeB(i, i+1, k);
+            for(int j: notches)
+                if(j>i+1 && j<k)
+                    typeB(i, j, k);
+        }
+    }
+
+    //walk down from 0..n-1. The pair chosen for i..k fixes the split vertex j: with a notch at i the piece holds the edge j-k
+    //and j-k is a cut, otherwise the piece holds i-j and i-j is a cut. When a != b the piece also takes in the sub-polygon on
+    //the other side, whose own pair must then agree with it: the same a next to i, or the same b next to k
+    struct Pending  {
+        int i, k, a, b;
+        bool isCut;
+    };
+    vector<Pending> pending = {{0, n-1, -1, -1, false}};
+    while(!pending.empty())  {
+        Pending current = pending.back();
+        pending.pop_back();
+        if(current.k-current.i<=1)
+            continue;
+        if(current.isCut)
+            diagonals.push_back({kept[n-1-current.i], kept[n-1-current.k]});
+        list<pair<int,int>> &pairs = state(current.i, current.k)->pairs;
+        auto chosen = pairs.end();
+        for(auto it = pairs.begin(); it!=pairs.end(); ++it)
+            if((current.a<0 || it->first==current.a) && (current.b<0 || it->second==current.b))
+                chosen = it;
+        if(chosen==pairs.end())
+            return NULL;
+        bool isMerged = chosen->first!=chosen->second;
+        if(!isConvex[current.i])  {
+            int j = chosen->second;
+            pending.push_back({j, current.k, -1, -1, true});
+            pending.push_back({current.i, j, isMerged ? chosen->first : -1, -1, !isMerged});
+        }
+        else  {
+            int j = chosen->first;
+            pending.push_back({current.i, j, -1, -1, true});
+            pending.push_back({j, current.k, -1, isMerged ? chosen->second : -1, !isMerged});
+        }
+    }
+    DCEL<T>* decomposition = decompositionFromDiagonals(verticesConst, diagonals);
+    for(auto face: decomposition->getFaces())  {
+        Edge<T>* edge = face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            if(isReflex(edge->getPrevEdge()->getOriginVertex(), edge->getOriginVertex(), edge->getNextEdge()->getOriginVertex()))  {
+                freeDCEL(decomposition);
+                return NULL;
+            }
+            edge = edge->getNextEdge();
+        }while(edge!=fixEdge);
+    }
+    return decomposition;
+}
+
+/**
+ * @brief Checks a decomposition against --max-vertices, for the engines that do not build their faces under the limit
+ * @brief O(E) time where E is the number of half edges of the decomposition, O(1) space
+ * @return true if no face has more than maxFaceVertices vertices, or when there is no limit
+ */
+
+bool isWithinVertexLimit(DCEL<T>* decomposition)  {
+    if(!maxFaceVertices)
+        return true;
+    for(auto face: decomposition->getFaces())  {
+        int count = 0;
+        Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            count++;
+            edge=edge->getNextEdge();
+        }while(edge!=fixEdge);
+        if(count>maxFaceVertices)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Fewest vertices a piece of the split mode is left with, smaller polygons are searched whole
+ */
+#define SPLIT_MINIMUM_VERTICES 32
+
+/**
+ * @brief Number of notches of a piece tried as one end of the cut splitting it
+ */
+#define SPLIT_SAMPLES 16
+
+//defined with the other drivers below, it searches its pieces with decomposePolygonBest
+DCEL<T>* decomposeSplit(vector<Vertex<T>*> &verticesConst, int pieces);
+
+/**
+ * @brief Runs the multi-start decomposition on a polygon and returns the decompositions with the fewest convex pieces
+ * @brief Worst Case Time Complexity- O(n^4) where n is the number of vertices in the original polygon
+ * @brief Worst Case Space Complexity- O(k n + m) where n is the number of vertices in the original polygon, k the number of decompositions kept
+ * and m the number of distinct remainders met, every other decomposition is freed as soon as it is beaten
+ *
+ * The partition a start cuts off next depends only on the vertices left, in the order they are stored, and on where the
+ * start scans them from. Each search records where it cut and how large the partition was under that remainder; a later
+ * start reaching the same remainder at the same scan position cuts the recorded partition again in O(n) instead of
+ * searching for it, and merges it into its own faces as the search would have. The decompositions are the same as
+ * without the memo.
+ * @param verticesConst vertices of the polygon in clockwise order, left untouched
+ * @param edgesConst edges of the polygon, left untouched
+ * @param keep how many decompositions to return
+ * @param withRectangles false to keep rectilinear polygons on their own vertices, decomposing them into convex pieces
+ * @param withSplit false to search the polygon whole even with --split, as its pieces are
+ * @return the best decompositions, fewest pieces first and among equals the one from the earliest start first
+ */
+
+vector<DCEL<T>*> decomposePolygonBest(vector<Vertex<T>*> &verticesConst, vector<Edge<T>*> &edgesConst, int keep, bool withRectangles = true, bool withSplit = true)  {
+    int numberOfVertices = verticesConst.size();
+    TraceSpan span("decompose", "vertices", numberOfVertices);
+    //rectilinear polygons are cut into the fewest rectangles, which may add vertices where the cuts end
+    if(rectangleEngine && withRectangles && keep==1)  {
+        TraceSpan engineSpan("rectangles");
+        int steinerCount;
+        DCEL<T>* rectangles = decomposeRectilinear(verticesConst, steinerCount);
+        //faces keep the points where other cuts end on their sides, so a rectangle can be over the limit
+        if(rectangles && !isWithinVertexLimit(rectangles))  {
+            freeDCEL(rectangles);
+            rectangles = NULL;
+        }
+        if(rectangles)  {
+            if(printSteps)  {
+                fout<<"Decomposed into rectangles, adding "<<steinerCount<<" vertices:\n";
+                printDecompositon(rectangles);
+            }
+            return {rectangles};
+        }
+    }
+    //convex polygons and those with one or two notches have a provably minimal decomposition without any search
+    if(fastPaths && keep==1)  {
+        TraceSpan engineSpan("few notches");
+        int notchCount;
+        DCEL<T>* direct = decomposeFewNotches(verticesConst, notchCount);
+        if(direct && !isWithinVertexLimit(direct))  {
+            freeDCEL(direct);
+            direct = NULL;
+        }
+        if(direct)  {
+            if(printSteps)  {
+                fout<<"Decomposed directly around "<<notchCount<<" notches:\n";
+                printDecompositon(direct);
+            }
+            return {direct};
+        }
+    }
+    //the exact engine is opt-in, its cost grows with the notches squared where the search only approximates the minimum
+    if(exactNotchLimit>=0 && keep==1)  {
+        TraceSpan engineSpan("exact");
+        int notchCount;
+        auto start = chrono::steady_clock::now();
+        DCEL<T>* exact = decomposeExact(verticesConst, exactNotchLimit, notchCount);
+        engineSpan.setArgument("notches", notchCount);
+        if(exact && !isWithinVertexLimit(exact))  {
+            freeDCEL(exact);
+            exact = NULL;
+        }
+        auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now()-start).count();
+        if(exact)  {
+            if(printSteps)  {
+                fout<<"Decomposed exactly around "<<notchCount<<" notches in "<<duration<<" microseconds:\n";
+                printDecompositon(exact);
+            }
+            return {exact};
+        }
+        if(printSteps && notchCount>exactNotchLimit)
+            fout<<notchCount<<" notches are over the exact limit of "<<exactNotchLimit<<", searching instead\n";
+    }
+    //the search grows much faster than the vertices, so a large polygon is searched faster in pieces, and those in parallel
+    if(splitPieces>1 && withSplit && keep==1 && numberOfVertices>=2*SPLIT_MINIMUM_VERTICES)  {
+        DCEL<T>* split = decomposeSplit(verticesConst, splitPieces);
+        if(split)
+            return {split};
+    }
+    vector<Vertex<T>*> vertices;
+    vector<Edge<T>*> edges;
+    deepCopy(vertices, edges, verticesConst, edgesConst);
+    //every start begins from the same polygon, so its notches are found once and only copied per start
+    vector<char> isNotchConst = notchFlags(verticesConst);
+    vector<char> isNotch = isNotchConst;
+
+    DCEL<T>* polygonDecomposition = NULL;
+    vector<tuple<int,int,DCEL<T>*>> retained;
+
+    //remainder (see remainderKey) -> partition the search cut from it as {start position, vertices, edges}, {0, 0, 0} when
+    //it found none; different starts often peel their way to the same remainder
+    map<pair<uint64_t,uint64_t>, array<int,3>> partitionMemo;
+    unordered_map<string,int> vertexIndex;
+    for(int i = 0; i<numberOfVertices; i++)
+        vertexIndex[verticesConst[i]->getId()] = i;
+
+    DCEL<T>* partitionPolygon = NULL;
+    DCEL<T>* firstPolygonPartition = NULL;
+    //first partition of the next start, already found while checking whether the start repeats the previous one
+    DCEL<T>* pendingPartition = NULL;
+    bool isFirstPolygonPartition = true;
+
+    int s = 0;
+    while(s<numberOfVertices)  {
+        TraceSpan startSpan("start", "s", s);
+        int countPartition = 1;
+        //partitions cut again from the memo instead of searched for
+        int replayed = 0;
+        bool isFirstCut = true;
+        do  {
+            if(pendingPartition)  {
+                partitionPolygon = pendingPartition;
+                pendingPartition = NULL;
+            }
+            else  {
+                //the whole polygon is only met once from each start, it is not looked up
+                bool isMemoized = memoizeRemainders && !isFirstCut;
+                pair<uint64_t,uint64_t> key;
+                auto seen = partitionMemo.end();
+                if(isMemoized)  {
+                    key = remainderKey(vertices, vertexIndex, s);
+                    seen = partitionMemo.find(key);
                 }
-                if(isFirstPolygonPartition)  {
-                    auto firstVertices = vertices;
-                    auto firstEdges = edges;
-                    deepCopy(firstVertices, firstEdges, partitionPolygon->getVertices(), partitionPolygon->getEdges());
-                    firstPolygonPartition = new DCEL<T>(firstVertices, firstEdges);
-                    isFirstPolygonPartition=false;
+                if(seen!=partitionMemo.end())  {
+                    array<int,3> cut = seen->second;
+                    partitionPolygon = cut[1] ? cutPartition(vertices, edges, isNotch, cut[0], cut[1], cut[2], countPartition) : NULL;
+                    replayed++;
                 }
-                if(partitionPolygon)  {
-                    fout<<"Partition "<<countPartition<<":\n";
-                    printPolygon(partitionPolygon->getEdges()[0]);
+                else  {
+                    int n = vertices.size();
+                    array<int,3> cut = {0, 0, 0};
+                    for(int i=0+s;i<vertices.size()+s;i++){
+                        partitionPolygon = returnPartitionAndUpdatePolygon(vertices, edges, isNotch, i, countPartition);
+                        if(partitionPolygon)  {
+                            cut = {i%n, (int)partitionPolygon->getVertices().size(), (int)partitionPolygon->getEdges().size()};
+                            break;
+                        }
+                    }
+                    if(isMemoized)
+                        partitionMemo[key] = cut;
                 }
-                polygonDecomposition = mergePartitionWithDecomposition(partitionPolygon, polygonDecomposition, countPartition);
+            }
+            isFirstCut = false;
+            if(isFirstPolygonPartition)  {
+                auto firstVertices = vertices;
+                auto firstEdges = edges;
+                deepCopy(firstVertices, firstEdges, partitionPolygon->getVertices(), partitionPolygon->getEdges());
+                //only the first partition of the latest start is compared against
+                if(firstPolygonPartition)
+                    freeDCEL(firstPolygonPartition);
+                firstPolygonPartition = new DCEL<T>(firstVertices, firstEdges);
+                isFirstPolygonPartition=false;
+            }
+            if(partitionPolygon && printSteps)  {
+                fout<<"Partition "<<countPartition<<":\n";
+                printPolygon(partitionPolygon->getEdges()[0]);
+            }
+            polygonDecomposition = mergePartitionWithDecomposition(partitionPolygon, polygonDecomposition, countPartition);
+            if(partitionPolygon && printSteps)
+                printDecompositon(polygonDecomposition);
+            countPartition++;
+        }
+        while(partitionPolygon && vertices.size()!=0); // i.e until a null pointer is returned
+        startSpan.setArgument("partitions", countPartition-1);
+        startSpan.setArgument("replayed", replayed);
+        retainDecomposition(retained, keep, countPartition, s, polygonDecomposition);
+        startSpan.end();
+        isFirstPolygonPartition=true;
+        polygonDecomposition=NULL;
+        deepCopy(vertices, edges, verticesConst, edgesConst);
+        isNotch = isNotchConst;
+        s++;
+        //finding the first partition of the next starts, skipping those that repeat this one
+        TraceSpan nextStartSpan("next start");
+        bool newFirstPolygon = false;
+        while(!newFirstPolygon && s<numberOfVertices)  {
+            //generate first polygon
+            for(int i=0;i<vertices.size();i++){
+                partitionPolygon = returnPartitionAndUpdatePolygon(vertices, edges, isNotch, i+s, 1);
                 if(partitionPolygon)
-                    printDecompositon(polygonDecomposition);
-                countPartition++;
+                    break;
             }
-            while(partitionPolygon && vertices.size()!=0); // i.e until a null pointer is returned
-            //fout<<"898\n";
-            if(countPartition<minimalCountPartition)  {
-                minimalPolygonDecomposition.clear();
-                minimalPolygonDecomposition.insert(polygonDecomposition);
-                minimalCountPartition=countPartition;
+            if(partitionPolygon && printSteps)  {
+                fout<<"First Partition only"<<":\n";
+                printPolygon(partitionPolygon->getEdges()[0]);
             }
-            else if(countPartition==minimalCountPartition){
-                minimalPolygonDecomposition.insert(polygonDecomposition);
+            if(polygonCompare(partitionPolygon, firstPolygonPartition))  {
+                s++;
+                //the trial partition and what is left of the copy are dropped
+                freeDCEL(partitionPolygon, vertices, edges);
+                deepCopy(vertices, edges, verticesConst, edgesConst);
+                isNotch = isNotchConst;
             }
-            isFirstPolygonPartition=true;
-            polygonDecomposition=NULL;
-            deepCopy(vertices, edges, verticesConst, edgesConst);
-            s++;
-            bool newFirstPolygon = false;
-            //fout<<"910\n";
-            while(!newFirstPolygon && s<numberOfVertices)  {
-                //generate first polygon
-                for(int i=0;i<vertices.size();i++){
-                    partitionPolygon = returnPartitionAndUpdatePolygon(vertices, edges, i+s, 1);
-                    if(partitionPolygon)
-                        break;
+            else  {
+                //the next start goes on from this partition and the copy it left, instead of finding it again
+                newFirstPolygon=true;
+                pendingPartition = partitionPolygon;
+            }
+        }
+    }
+    if(firstPolygonPartition)
+        freeDCEL(firstPolygonPartition);
+    freeDCEL(new DCEL<T>(vertices, edges));
+
+    vector<DCEL<T>*> best;
+    for(auto &entry: retained)
+        best.push_back(get<2>(entry));
+    return best;
+}
+
+/**
+ * @brief Runs the multi-start decomposition on a polygon and returns a decomposition with the fewest convex pieces
+ * @brief Worst Case Time Complexity- O(n^4) where n is the number of vertices in the original polygon
+ * @brief Worst Case Space Complexity- O(n) where n is the number of vertices in the original polygon
+ * @param verticesConst vertices of the polygon in clockwise order, left untouched
+ * @param edgesConst edges of the polygon, left untouched
+ * @param withRectangles false to keep rectilinear polygons on their own vertices, decomposing them into convex pieces
+ * @return Pointer to the DCEL of the best decomposition
+ */
+
+DCEL<T>* decomposePolygon(vector<Vertex<T>*> &verticesConst, vector<Edge<T>*> &edgesConst, bool withRectangles = true)  {
+    return decomposePolygonBest(verticesConst, edgesConst, 1, withRectangles)[0];
+}
+
+/**
+ * @brief Finds a diagonal cutting a sub-polygon into two parts of similar size, for the split mode
+ * @brief O(c m) time where m is the size of the ring and c the number of candidates tried, at most 3 per sampled notch; O(r) space for the r notches
+ *
+ * The cut starts at a notch, so the notch may be resolved by it. The other end is taken where a long diagonal is likely:
+ * at the ends of the nearest edge the bisector of the reflex angle hits, and opposite the notch in ring order. Up to
+ * SPLIT_SAMPLES notches spread over the ring are tried, and the diagonal with the most vertices on its smaller side wins.
+ * @param vertices vertices of the polygon
+ * @param ring positions in vertices of a clockwise sub-polygon
+ * @return positions in ring of the two ends, {-1, -1} when the ring is convex or no cut leaves SPLIT_MINIMUM_VERTICES on both sides
+ */
+
+pair<int,int> balancedDiagonal(vector<Vertex<T>*> &vertices, vector<int> &ring)  {
+    int m = ring.size();
+    vector<int> notches;
+    for(int i = 0; i<m; i++)
+        if(isReflex(vertices[ring[(i+m-1)%m]], vertices[ring[i]], vertices[ring[(i+1)%m]]))
+            notches.push_back(i);
+    pair<int,int> best = {-1, -1};
+    int bestSide = SPLIT_MINIMUM_VERTICES-1;
+    int samples = min<int>(SPLIT_SAMPLES, notches.size());
+    for(int k = 0; k<samples; k++)  {
+        int a = notches[(long long)k*notches.size()/samples];
+        Point previous = vertices[ring[(a+m-1)%m]]->getCoordinate(), notch = vertices[ring[a]]->getCoordinate(), next = vertices[ring[(a+1)%m]]->getCoordinate();
+        //the unit vectors to the neighbours add up inside the convex outer angle, so their negation points into the reflex one
+        double x1 = (double)previous.first-notch.first, y1 = (double)previous.second-notch.second;
+        double x2 = (double)next.first-notch.first, y2 = (double)next.second-notch.second;
+        double length1 = hypot(x1, y1), length2 = hypot(x2, y2);
+        vector<int> ends = {(a+m/2)%m};
+        if(length1>0 && length2>0)  {
+            double dx = -(x1/length1+x2/length2), dy = -(y1/length1+y2/length2), nearest = DBL_MAX;
+            int hit = -1;
+            for(int e = 0; e<m; e++)  {
+                if(e==a || (e+1)%m==a)
+                    continue;
+                Point p = vertices[ring[e]]->getCoordinate(), q = vertices[ring[(e+1)%m]]->getCoordinate();
+                double ex = (double)q.first-p.first, ey = (double)q.second-p.second, denominator = dx*ey-dy*ex;
+                if(denominator==0)
+                    continue;
+                double px = (double)p.first-notch.first, py = (double)p.second-notch.second;
+                double t = (px*ey-py*ex)/denominator, u = (px*dy-py*dx)/denominator;
+                if(t>0 && u>=0 && u<=1 && t<nearest)  {
+                    nearest = t;
+                    hit = e;
                 }
-                if(partitionPolygon)  {
-                    fout<<"First Partition only"<<":\n";
-                    printPolygon(partitionPolygon->getEdges()[0]);
+            }
+            if(hit>=0)  {
+                ends.push_back(hit);
+                ends.push_back((hit+1)%m);
+            }
+        }
+        for(int b: ends)  {
+            //the arc from a to b and the one back share both ends
+            int side = min((b-a+m)%m+1, (a-b+m)%m+1);
+            if(side>bestSide && isDiagonal(vertices, ring, a, b))  {
+                best = {a, b};
+                bestSide = side;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Decomposes a large polygon by cutting it into pieces searched in parallel and stitching their decompositions
+ * @brief O(p c n) time for the cuts where p is the number of pieces and c the candidates tried per cut, plus the search
+ * of every piece on its own thread and O(n log n) for the stitching; O(n) space besides the searches
+ *
+ * The largest piece is cut along balancedDiagonal until there are the pieces asked for, or no piece has a cut leaving
+ * SPLIT_MINIMUM_VERTICES on both sides. Each piece is searched whole (with the fast paths, without rectangles, which
+ * would add vertices on the cuts). A cut is then removed wherever the two faces on its sides form a convex polygon
+ * together; the cuts left are the price of the parallelism, each costs at most one piece over searching the polygon whole.
+ * @param verticesConst vertices of the polygon in clockwise order, left untouched
+ * @param pieces most pieces to cut the polygon into
+ * @return Pointer to the DCEL of the decomposition, NULL when the polygon could not be cut
+ */
+
+DCEL<T>* decomposeSplit(vector<Vertex<T>*> &verticesConst, int pieces)  {
+    int n = verticesConst.size();
+    TraceSpan splitSpan("split", "vertices", n);
+    vector<vector<int>> leaves(1, vector<int>(n));
+    iota(leaves[0].begin(), leaves[0].end(), 0);
+    vector<char> isUncut(1, 0);
+    vector<pair<int,int>> cuts;
+    while(leaves.size()<pieces)  {
+        int largest = -1;
+        for(int l = 0; l<leaves.size(); l++)
+            if(!isUncut[l] && leaves[l].size()>=2*SPLIT_MINIMUM_VERTICES && (largest<0 || leaves[l].size()>leaves[largest].size()))
+                largest = l;
+        if(largest<0)
+            break;
+        pair<int,int> diagonal = balancedDiagonal(verticesConst, leaves[largest]);
+        if(diagonal.first<0)  {
+            isUncut[largest] = 1;
+            continue;
+        }
+        cuts.push_back({leaves[largest][diagonal.first], leaves[largest][diagonal.second]});
+        vector<int> first = ringArc(leaves[largest], diagonal.first, diagonal.second);
+        vector<int> second = ringArc(leaves[largest], diagonal.second, diagonal.first);
+        leaves[largest] = first;
+        leaves.push_back(second);
+        isUncut.push_back(0);
+    }
+    splitSpan.setArgument("cuts", cuts.size());
+    splitSpan.end();
+    if(cuts.empty())
+        return NULL;
+
+    unordered_map<string,int> vertexIndex;
+    for(int i = 0; i<n; i++)
+        vertexIndex[verticesConst[i]->getId()] = i;
+    //faces of every piece as positions in verticesConst, clockwise
+    vector<vector<vector<int>>> leafFaces(leaves.size());
+    auto decomposeLeaf = [&](int l)  {
+        TraceSpan span("piece", "vertices", leaves[l].size());
+        vector<Vertex<T>*> vertices;
+        vector<Edge<T>*> edges;
+        for(int i: leaves[l])
+            appendPolygonVertex(vertices, edges, verticesConst[i]->getId(), verticesConst[i]->getCoordinate());
+        DCEL<T>* decomposition = decomposePolygonBest(vertices, edges, 1, false, false)[0];
+        for(auto face: decomposition->getFaces())  {
+            vector<int> faceRing;
+            Edge<T>* edge = face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+            do  {
+                faceRing.push_back(vertexIndex.at(edge->getOriginVertex()->getId()));
+                edge = edge->getNextEdge();
+            }while(edge!=fixEdge);
+            leafFaces[l].push_back(faceRing);
+        }
+        freeDCEL(decomposition);
+        freeDCEL(new DCEL<T>(vertices, edges));
+    };
+    if(printSteps)  {
+        //the step trace is one file, so the pieces are searched one after the other
+        fout<<"Split into "<<leaves.size()<<" pieces along "<<cuts.size()<<" diagonals\n";
+        for(int l = 0; l<leaves.size(); l++)  {
+            fout<<"Piece "<<l+1<<":\n";
+            decomposeLeaf(l);
+        }
+    }
+    else  {
+        vector<thread> pieceThreads;
+        for(int l = 1; l<leaves.size(); l++)
+            pieceThreads.push_back(thread([&, l]()  {
+                traceRecorder.nameThread("piece "+to_string(l+1));
+                decomposeLeaf(l);
+            }));
+        decomposeLeaf(0);
+        for(auto &pieceThread: pieceThreads)
+            pieceThread.join();
+    }
+
+    TraceSpan stitchSpan("stitch", "cuts", cuts.size());
+    vector<vector<int>> faces;
+    for(auto &pieceFaces: leafFaces)
+        for(auto &face: pieceFaces)
+            faces.push_back(move(face));
+    //the face on each side of every cut, the side a -> b belongs to the face walking from a to b
+    map<pair<int,int>,int> sideOf;
+    for(auto &cut: cuts)  {
+        sideOf[cut] = -1;
+        sideOf[{cut.second, cut.first}] = -1;
+    }
+    for(int f = 0; f<faces.size(); f++)
+        for(int k = 0; k<faces[f].size(); k++)  {
+            auto side = sideOf.find({faces[f][k], faces[f][(k+1)%faces[f].size()]});
+            if(side!=sideOf.end())
+                side->second = f;
+        }
+    int removed = 0;
+    for(auto &cut: cuts)  {
+        int a = cut.first, b = cut.second, f = sideOf[cut], g = sideOf[{b, a}];
+        vector<int> &faceF = faces[f], &faceG = faces[g];
+        int p = faceF.size(), q = faceG.size();
+        //faceF runs ... a b ..., faceG runs ... b a ...
+        int i = find(faceF.begin(), faceF.end(), a)-faceF.begin(), j = find(faceG.begin(), faceG.end(), b)-faceG.begin();
+        if(isReflex(verticesConst[faceF[(i+p-1)%p]], verticesConst[a], verticesConst[faceG[(j+2)%q]])
+           || isReflex(verticesConst[faceG[(j+q-1)%q]], verticesConst[b], verticesConst[faceF[(i+2)%p]])
+           || (maxFaceVertices && p+q-2>maxFaceVertices))
+            continue;
+        //faceF from b round to a, then faceG from after a round to before b
+        vector<int> merged;
+        for(int k = 1; k<=p; k++)
+            merged.push_back(faceF[(i+k)%p]);
+        for(int k = 2; k<q; k++)
+            merged.push_back(faceG[(j+k)%q]);
+        faces[f] = merged;
+        faces[g].clear();
+        for(auto &side: sideOf)
+            if(side.second==g)
+                side.second = f;
+        removed++;
+    }
+    //every diagonal is walked once each way, it is kept from the side starting at its lower end
+    vector<pair<int,int>> diagonals;
+    for(auto &face: faces)
+        for(int k = 0; k<face.size(); k++)  {
+            int u = face[k], v = face[(k+1)%face.size()];
+            if(u<v && v!=u+1)
+                diagonals.push_back({u, v});
+        }
+    DCEL<T>* decomposition = decompositionFromDiagonals(verticesConst, diagonals);
+    stitchSpan.setArgument("removed", removed);
+    if(printSteps)  {
+        fout<<"Stitched the pieces, "<<removed<<" of the "<<cuts.size()<<" cuts were not needed:\n";
+        printDecompositon(decomposition);
+    }
+    return decomposition;
+}
+
+/**
+ * @brief Kinds of single vertex edits on the polygon boundary
+ */
+enum PolygonEditType  { MOVE_VERTEX, INSERT_VERTEX, DELETE_VERTEX };
+
+/**
+ * @struct PolygonEdit
+ * @brief A single vertex edit
+ * MOVE_VERTEX moves vertex id to coordinate,
+ * INSERT_VERTEX inserts vertex newId at coordinate on the boundary edge leaving vertex id,
+ * DELETE_VERTEX removes vertex id, joining its two neighbours
+ */
+struct PolygonEdit  {
+    PolygonEditType type;
+    string id;
+    string newId;
+    Point coordinate;
+};
+
+/**
+ * @class IndexedList
+ * @brief Vector of pointers with O(1) insertion and O(1) removal by swapping with the last element
+ */
+template <class P>
+class IndexedList  {
+private:
+    vector<P> items;
+    unordered_map<P,int> position;
+
+public:
+    void insert(P item)  {
+        position[item] = items.size();
+        items.push_back(item);
+    }
+
+    void erase(P item)  {
+        auto it = position.find(item);
+        if(it==position.end())
+            return;
+        int i = it->second;
+        items[i] = items.back();
+        position[items[i]] = i;
+        items.pop_back();
+        position.erase(item);
+    }
+
+    vector<P> &getItems()  {
+        return items;
+    }
+};
+
+/**
+ * @class IncrementalDecomposition
+ * @brief Keeps a decomposition up to date under single vertex edits, re-decomposing only the faces an edit touches
+ *
+ * The faces around the edited vertex (or the face of the edited boundary edge) are taken, grown by any
+ * neighbouring face the new boundary would cut into, merged into one polygon through the twin links,
+ * decomposed again with decomposePolygon and stitched back to the untouched faces through the twin links.
+ * The new boundary pieces are checked against the rest of the polygon through a uniform grid of its boundary
+ * edges, updated with every edit, so an edit costs time in the size of that region and of the boundary near it,
+ * not of the polygon (except for the rare edits that fall back to the whole polygon, see applyEdit).
+ * The faces are found through the vertices of the polygon, so the decomposition must not add any: rectilinear
+ * polygons are decomposed with decomposePolygon(vertices, edges, false).
+ */
+class IncrementalDecomposition  {
+private:
+    IndexedList<Vertex<T>*> vertices;
+    IndexedList<Edge<T>*> edges;
+    IndexedList<Face<T>*> faces;
+    unordered_map<string, Vertex<T>*> vertexById;
+    int nextFaceId = 1;
+    //boundary edges of the polygon (those without a twin) in square cells of side cellSize, keyed by column and row
+    unordered_map<long long, vector<Edge<T>*>> boundaryCells;
+    double cellSize = 1;
+
+    /**
+     * @brief Calls visit with the key of every cell the segment a-b passes through, column by column
+     * @brief O(c) time where c is the number of cells visited, about the length of the segment over cellSize
+     */
+    template <class F>
+    void forEachCell(Point a, Point b, F visit)  {
+        //a hair of slack so that a segment running along a cell border is found from both sides
+        double slack = 1e-9*cellSize;
+        if(a.first>b.first)
+            swap(a, b);
+        long long firstColumn = floor((a.first-slack)/cellSize), lastColumn = floor((b.first+slack)/cellSize);
+        for(long long column = firstColumn; column<=lastColumn; column++)  {
+            //the part of the segment inside this column
+            double x0 = max((double)a.first, column*cellSize), x1 = min((double)b.first, (column+1)*cellSize);
+            double y0 = a.second, y1 = b.second;
+            if(b.first>a.first)  {
+                double slope = ((double)b.second-a.second)/((double)b.first-a.first);
+                y0 = a.second+slope*(x0-a.first);
+                y1 = a.second+slope*(x1-a.first);
+            }
+            long long firstRow = floor((min(y0, y1)-slack)/cellSize), lastRow = floor((max(y0, y1)+slack)/cellSize);
+            for(long long row = firstRow; row<=lastRow; row++)
+                visit((column<<32)^(row&0xffffffffLL));
+        }
+    }
+
+    /**
+     * @brief Adds a boundary edge to the cells it passes through, or removes it from them
+     * @brief O(c + b) time where c is the number of cells of the edge and b the boundary edges in them
+     */
+    void indexBoundaryEdge(Edge<T>* edge, bool isAdded)  {
+        forEachCell(edge->getOriginVertex()->getCoordinate(), edge->getNextEdge()->getOriginVertex()->getCoordinate(), [&](long long key)  {
+            vector<Edge<T>*> &cell = boundaryCells[key];
+            if(isAdded)
+                cell.push_back(edge);
+            else  {
+                auto it = find(cell.begin(), cell.end(), edge);
+                if(it!=cell.end())  {
+                    *it = cell.back();
+                    cell.pop_back();
+                }
+                if(cell.empty())
+                    boundaryCells.erase(key);
+            }
+        });
+    }
+
+    /**
+     * @brief Returns the boundary edges sharing a cell with the segment a-b, each once
+     * @brief O(c + b) time where c is the number of cells of the segment and b the boundary edges in them
+     */
+    vector<Edge<T>*> boundaryEdgesNear(Point a, Point b)  {
+        vector<Edge<T>*> near;
+        unordered_set<Edge<T>*> isNear;
+        forEachCell(a, b, [&](long long key)  {
+            auto cell = boundaryCells.find(key);
+            if(cell!=boundaryCells.end())
+                for(auto edge: cell->second)
+                    if(isNear.insert(edge).second)
+                        near.push_back(edge);
+        });
+        return near;
+    }
+
+    /**
+     * @brief Returns the boundary edge of the polygon leaving v, rotating around v through the twins
+     * @brief O(d) time where d is the number of faces around v
+     */
+    Edge<T>* boundaryOutEdge(Vertex<T>* vertex)  {
+        Edge<T>* edge = vertex->getIncidentEdge();
+        int guard = edges.getItems().size();
+        while(edge->getTwinEdge() && guard--)
+            edge = edge->getTwinEdge()->getNextEdge();
+        return edge;
+    }
+
+    /**
+     * @brief Returns the boundary edge of the polygon entering v, rotating around v the other way
+     * @brief O(d) time where d is the number of faces around v
+     */
+    Edge<T>* boundaryInEdge(Vertex<T>* vertex)  {
+        Edge<T>* edge = boundaryOutEdge(vertex);
+        int guard = edges.getItems().size();
+        while(edge->getPrevEdge()->getTwinEdge() && guard--)
+            edge = edge->getPrevEdge()->getTwinEdge();
+        return edge->getPrevEdge();
+    }
+
+    /**
+     * @brief Returns the faces around v, from the one left of its outgoing boundary edge onwards
+     * @brief O(d) time where d is the number of faces around v
+     */
+    vector<Face<T>*> facesAround(Vertex<T>* vertex)  {
+        vector<Face<T>*> around;
+        Edge<T>* edge = boundaryOutEdge(vertex);
+        around.push_back(edge->getLeftFace());
+        while(edge->getPrevEdge()->getTwinEdge())  {
+            edge = edge->getPrevEdge()->getTwinEdge();
+            around.push_back(edge->getLeftFace());
+        }
+        return around;
+    }
+
+    /**
+     * @brief Checks if a face is cut by one of the new boundary segments or holds one of the new points
+     * @brief O(k) time where k is the number of vertices of the face
+     */
+    bool isTouchedBy(Face<T>* face, vector<line> &segments, vector<Point> &points)  {
+        vector<bool> isInside(points.size(), true);
+        Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            line side = {edge->getOriginVertex()->getCoordinate(), edge->getNextEdge()->getOriginVertex()->getCoordinate()};
+            for(auto &segment: segments)
+                if(segmentsIntersect(side, segment))
+                    return true;
+            //faces are convex and clockwise, a point inside lies right of every side
+            for(int i = 0; i<points.size(); i++)
+                if(direction(side.p1, side.p2, points[i])!=1)
+                    isInside[i] = false;
+            edge=edge->getNextEdge();
+        }while(edge!=fixEdge);
+        for(int i = 0; i<points.size(); i++)
+            if(isInside[i])
+                return true;
+        return false;
+    }
+
+    /**
+     * @brief Walks the outer boundary of a set of faces, clockwise
+     * @brief O(r) time where r is the number of edges of the faces
+     * @return the boundary edges, empty if the boundary is not a single simple cycle
+     */
+    vector<Edge<T>*> regionBoundary(unordered_set<Face<T>*> &region)  {
+        vector<Edge<T>*> candidates;
+        for(auto face: region)  {
+            Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+            do  {
+                if(!edge->getTwinEdge() || !region.count(edge->getTwinEdge()->getLeftFace()))
+                    candidates.push_back(edge);
+                edge=edge->getNextEdge();
+            }while(edge!=fixEdge);
+        }
+        vector<Edge<T>*> boundary;
+        unordered_set<Vertex<T>*> isVisited;
+        Edge<T>* edge = candidates[0];
+        do  {
+            //a vertex met twice pinches the region, it is not a simple polygon
+            if(!isVisited.insert(edge->getOriginVertex()).second)
+                return vector<Edge<T>*>();
+            boundary.push_back(edge);
+            Edge<T>* next = edge->getNextEdge();
+            while(next->getTwinEdge() && region.count(next->getTwinEdge()->getLeftFace()))
+                next = next->getTwinEdge()->getNextEdge();
+            edge = next;
+        }while(edge!=candidates[0] && boundary.size()<=candidates.size());
+        if(boundary.size()!=candidates.size())
+            return vector<Edge<T>*>();
+        return boundary;
+    }
+
+    /**
+     * @brief Checks the new boundary pieces against the boundary edges of the polygon that stay, found through the grid
+     * @brief O(c + b) time where c is the number of cells the pieces pass through and b the boundary edges in them
+     *
+     * A piece that bulges out of the polygon never enters a face, so growing the region cannot catch it hitting the polygon elsewhere.
+     */
+    bool isCrossingBoundary(vector<line> &segments, vector<Point> &points, unordered_set<Edge<T>*> &isReplaced)  {
+        //every vertex is the origin of a boundary edge, which is in the cell of the vertex
+        for(auto &point: points)
+            for(auto edge: boundaryEdgesNear(point, point))
+                if(edge->getOriginVertex()->getCoordinate()==point)
+                    return true;
+        for(auto &segment: segments)
+            for(auto edge: boundaryEdgesNear(segment.p1, segment.p2))  {
+                if(isReplaced.count(edge))
+                    continue;
+                line side = {edge->getOriginVertex()->getCoordinate(), edge->getNextEdge()->getOriginVertex()->getCoordinate()};
+                if(segmentsIntersect(side, segment))
+                    return true;
+            }
+        return false;
+    }
+
+public:
+    /**
+     * @brief Takes over a finished decomposition, its faces and edges are reused and updated in place
+     * @brief O(n) time and space, once
+     * @param decomposition decomposition returned by decomposePolygon, twins linking all its diagonals
+     */
+    IncrementalDecomposition(DCEL<T>* decomposition)  {
+        for(auto face: decomposition->getFaces())  {
+            faces.insert(face);
+            nextFaceId = max(nextFaceId, face->getId()+1);
+            Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+            do  {
+                edges.insert(edge);
+                edge->setLeftFace(face);
+                Vertex<T>* vertex = edge->getOriginVertex();
+                if(!vertexById.count(vertex->getId()))  {
+                    vertices.insert(vertex);
+                    vertexById[vertex->getId()] = vertex;
+                }
+                //the decomposition may have left vertices pointing at removed diagonals
+                edge->getOriginVertex()->setIncidentEdge(edge);
+                edge=edge->getNextEdge();
+            }while(edge!=fixEdge);
+        }
+        //cells as large as the average boundary edge, so an edge of usual length spans a few cells
+        double length = 0;
+        int boundaryCount = 0;
+        for(auto edge: edges.getItems())
+            if(!edge->getTwinEdge())  {
+                Point a = edge->getOriginVertex()->getCoordinate(), b = edge->getNextEdge()->getOriginVertex()->getCoordinate();
+                length += hypot((double)b.first-a.first, (double)b.second-a.second);
+                boundaryCount++;
+            }
+        if(boundaryCount && length>0)
+            cellSize = length/boundaryCount;
+        for(auto edge: edges.getItems())
+            if(!edge->getTwinEdge())
+                indexBoundaryEdge(edge, true);
+    }
+
+    /**
+     * @brief Applies an edit and re-decomposes the faces it affects
+     * @brief O(r^4 + c + b) worst case time where r is the number of vertices of the affected region, c the number of grid
+     * cells the new boundary pieces pass through and b the boundary edges in those cells. An edit whose region would not
+     * be a simple polygon (faces pinched at a vertex) falls back to the whole polygon, r is n then.
+     * @param edit the edit
+     * @return false if the edit is invalid (unknown ids, fewer than 3 vertices left, or a boundary crossing itself), nothing is changed then
+     */
+    bool applyEdit(PolygonEdit edit)  {
+        if(!vertexById.count(edit.id))
+            return false;
+        if(edit.type==INSERT_VERTEX && vertexById.count(edit.newId))
+            return false;
+        if(edit.type==DELETE_VERTEX && vertices.getItems().size()<=3)
+            return false;
+        Vertex<T>* vertex = vertexById[edit.id];
+        Edge<T>* outEdge = boundaryOutEdge(vertex);
+        Edge<T>* inEdge = boundaryInEdge(vertex);
+        Vertex<T>* previous = inEdge->getOriginVertex();
+        Vertex<T>* next = outEdge->getNextEdge()->getOriginVertex();
+
+        //the new boundary pieces, and the old boundary edges they replace
+        vector<line> segments;
+        vector<Point> points;
+        unordered_set<Edge<T>*> isReplaced;
+        unordered_set<Face<T>*> region;
+        if(edit.type==MOVE_VERTEX)  {
+            segments.push_back({previous->getCoordinate(), edit.coordinate});
+            segments.push_back({edit.coordinate, next->getCoordinate()});
+            points.push_back(edit.coordinate);
+            isReplaced = {inEdge, outEdge};
+        }
+        else if(edit.type==INSERT_VERTEX)  {
+            segments.push_back({vertex->getCoordinate(), edit.coordinate});
+            segments.push_back({edit.coordinate, next->getCoordinate()});
+            points.push_back(edit.coordinate);
+            isReplaced = {outEdge};
+        }
+        else  {
+            segments.push_back({previous->getCoordinate(), next->getCoordinate()});
+            isReplaced = {inEdge, outEdge};
+        }
+        if(edit.type==INSERT_VERTEX)
+            region.insert(outEdge->getLeftFace());
+        else
+            for(auto face: facesAround(vertex))
+                region.insert(face);
+
+        //grow the region by every neighbouring face the new boundary cuts into
+        vector<Edge<T>*> boundary;
+        bool isGrown = true;
+        while(isGrown)  {
+            isGrown = false;
+            boundary = regionBoundary(region);
+            if(boundary.empty())  {
+                //not a simple region, fall back to the whole polygon
+                for(auto face: faces.getItems())
+                    region.insert(face);
+                boundary = regionBoundary(region);
+                break;
+            }
+            //deleting the tip of a triangle leaves nothing, the faces next to it have to be taken as well
+            bool isTooSmall = edit.type==DELETE_VERTEX && boundary.size()<4;
+            for(auto edge: boundary)  {
+                if(edge->getTwinEdge() && !region.count(edge->getTwinEdge()->getLeftFace()) && (isTooSmall || isTouchedBy(edge->getTwinEdge()->getLeftFace(), segments, points)))  {
+                    region.insert(edge->getTwinEdge()->getLeftFace());
+                    isGrown = true;
+                }
+            }
+        }
+        if(boundary.empty())
+            return false;
+        //the new pieces must not cross the rest of the polygon, nor what is left of the region boundary
+        if(isCrossingBoundary(segments, points, isReplaced))
+            return false;
+        for(auto edge: boundary)  {
+            if(isReplaced.count(edge))
+                continue;
+            line side = {edge->getOriginVertex()->getCoordinate(), edge->getNextEdge()->getOriginVertex()->getCoordinate()};
+            for(auto &segment: segments)
+                if(segmentsIntersect(side, segment))
+                    return false;
+        }
+
+        //ring of the region with the edit applied
+        vector<Vertex<T>*> ring;
+        unordered_map<Vertex<T>*, Edge<T>*> outsideTwin;
+        Vertex<T>* inserted = NULL;
+        for(auto edge: boundary)  {
+            Vertex<T>* origin = edge->getOriginVertex();
+            if(edit.type!=DELETE_VERTEX || origin!=vertex)
+                ring.push_back(origin);
+            if(edit.type==INSERT_VERTEX && origin==vertex)  {
+                inserted = new Vertex<T>(edit.newId, edit.coordinate);
+                ring.push_back(inserted);
+            }
+            if(edge->getTwinEdge())
+                outsideTwin[origin] = edge->getTwinEdge();
+        }
+        vector<Point> ringCoordinates;
+        for(auto v: ring)
+            ringCoordinates.push_back(v==vertex && edit.type==MOVE_VERTEX ? edit.coordinate : v->getCoordinate());
+        //an edit that turns the region inside out (a tip dragged or cut across its base) leaves it anticlockwise
+        double area = 0;
+        for(int i = 0; i<ringCoordinates.size(); i++)  {
+            Point a = ringCoordinates[i], b = ringCoordinates[(i+1)%ringCoordinates.size()];
+            area += (double)a.first*b.second-(double)b.first*a.second;
+        }
+        if(ring.size()<3 || area>=0)  {
+            delete inserted;
+            return false;
+        }
+        //the boundary edges of the region go, taken out of the grid while the moved vertex still has its old place
+        for(auto face: region)  {
+            Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+            do  {
+                if(!edge->getTwinEdge())
+                    indexBoundaryEdge(edge, false);
+                edge=edge->getNextEdge();
+            }while(edge!=fixEdge);
+        }
+        if(edit.type==MOVE_VERTEX)
+            vertex->setCoordinate(edit.coordinate);
+
+        vector<Vertex<T>*> regionVertices;
+        vector<Edge<T>*> regionEdges;
+        for(int i = 0; i<ring.size(); i++)
+            appendPolygonVertex(regionVertices, regionEdges, ring[i]->getId(), ringCoordinates[i]);
+        DCEL<T>* regionDecomposition = decomposePolygon(regionVertices, regionEdges, false);
+
+        //drop the old faces, boundary edges towards untouched faces are re-linked below
+        for(auto face: region)  {
+            Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+            vector<Edge<T>*> cycle;
+            do  {
+                cycle.push_back(edge);
+                edge=edge->getNextEdge();
+            }while(edge!=fixEdge);
+            for(auto e: cycle)  {
+                edges.erase(e);
+                delete e;
+            }
+            faces.erase(face);
+            delete face;
+        }
+        if(edit.type==DELETE_VERTEX)  {
+            vertices.erase(vertex);
+            vertexById.erase(vertex->getId());
+            delete vertex;
+        }
+        if(inserted)  {
+            vertices.insert(inserted);
+            vertexById[inserted->getId()] = inserted;
+        }
+
+        //rebuild the new faces on the shared vertices
+        map<pair<Vertex<T>*,Vertex<T>*>, Edge<T>*> newEdges;
+        for(auto regionFace: regionDecomposition->getFaces())  {
+            Face<T>* face = new Face<T>(nextFaceId++, NULL);
+            vector<Edge<T>*> cycle;
+            Edge<T>* edge=regionFace->getIncidentEdge(), *fixEdge = regionFace->getIncidentEdge();
+            do  {
+                Edge<T>* copy = new Edge<T>(vertexById[edge->getOriginVertex()->getId()]);
+                copy->setLeftFace(face);
+                cycle.push_back(copy);
+                edge=edge->getNextEdge();
+            }while(edge!=fixEdge);
+            for(int i = 0; i<cycle.size(); i++)  {
+                cycle[i]->setNextEdge(cycle[(i+1)%cycle.size()]);
+                cycle[(i+1)%cycle.size()]->setPrevEdge(cycle[i]);
+                cycle[i]->getOriginVertex()->setIncidentEdge(cycle[i]);
+                newEdges[{cycle[i]->getOriginVertex(), cycle[(i+1)%cycle.size()]->getOriginVertex()}] = cycle[i];
+                edges.insert(cycle[i]);
+            }
+            face->setIncidentEdge(cycle[0]);
+            faces.insert(face);
+        }
+
+        //twins inside the region, then across the region boundary
+        for(auto &it: newEdges)  {
+            Edge<T>* edge = it.second;
+            auto twin = newEdges.find({it.first.second, it.first.first});
+            if(twin!=newEdges.end())
+                edge->setTwinEdge(twin->second);
+            else if(outsideTwin.count(it.first.first) && outsideTwin[it.first.first]->getOriginVertex()==it.first.second)  {
+                edge->setTwinEdge(outsideTwin[it.first.first]);
+                outsideTwin[it.first.first]->setTwinEdge(edge);
+            }
+        }
+        for(auto &it: newEdges)
+            if(!it.second->getTwinEdge())
+                indexBoundaryEdge(it.second, true);
+        //the faces were copied onto the shared vertices, the region polygon and its decomposition are not referenced any more
+        freeDCEL(regionDecomposition, regionVertices, regionEdges);
+        return true;
+    }
+
+    /**
+     * @brief Returns the current decomposition
+     * @brief O(n) time and space
+     */
+    DCEL<T>* getDecomposition()  {
+        return new DCEL<T>(vertices.getItems(), edges.getItems(), faces.getItems());
+    }
+
+    /**
+     * @brief Returns the current polygon, its vertices in clockwise order
+     * @brief O(n) time and space
+     */
+    DCEL<T>* getPolygon()  {
+        vector<Vertex<T>*> ring;
+        Vertex<T>* first = vertices.getItems()[0];
+        Vertex<T>* vertex = first;
+        do  {
+            ring.push_back(vertex);
+            vertex = boundaryOutEdge(vertex)->getNextEdge()->getOriginVertex();
+        }while(vertex!=first && ring.size()<=vertices.getItems().size());
+        return new DCEL<T>(ring, vector<Edge<T>*>());
+    }
+};
+
+/**
+ * @brief Runs the simplification pre-pass chosen on the command line
+ * @brief O(n) time for the exact removal, see simplifyRing for the tolerance
+ * @param ring vertices of the polygon, in clockwise order
+ * @return positions in ring of the vertices to decompose, every position when the pre-pass is off
+ */
+
+vector<int> simplifiedPositions(vector<Point> &ring)  {
+    if(simplifyTolerance<0)  {
+        vector<int> positions(ring.size());
+        iota(positions.begin(), positions.end(), 0);
+        return positions;
+    }
+    return simplifyRing(ring, simplifyTolerance);
+}
+
+/**
+ * @struct StreamedPolygon
+ * @brief A polygon travelling through the stages of decomposeStream, index -1 tells a stage to stop
+ */
+struct StreamedPolygon  {
+    long long index = -1;
+    vector<Point> ring;
+    DCEL<T>* decomposition = NULL;
+};
+
+/**
+ * @brief Decomposes every polygon of a GeoJSON or WKT file and streams the convex faces to a GeoJSON or WKT file
+ * @brief Time is that of decomposePolygon summed over the polygons, divided among the workers
+ *
+ * The file is read on the calling thread, the polygons are decomposed by streamThreads workers and written in input order
+ * by a writer thread, the stages being joined by bounded queues. Parsing the next polygons and writing the previous ones
+ * overlaps the decomposition of the current ones, and a slow stage blocks the ones feeding it, so at most about four
+ * polygons per worker are held in memory whatever the size of the file.
+ * @param inputFile path of the input file
+ * @param inputIsGeoJSON true for GeoJSON input, false for WKT
+ * @param outputFile path of the output file
+ * @param outputIsGeoJSON true for GeoJSON output, false for WKT
+ * @return 0 on success, 1 if a file could not be opened or parsed
+ */
+
+int decomposeStream(string inputFile, bool inputIsGeoJSON, string outputFile, bool outputIsGeoJSON)  {
+    ifstream in(inputFile);
+    ofstream out(outputFile);
+    if(!in || !out)  {
+        cerr<<"Could not open "<<(in ? outputFile : inputFile)<<"\n";
+        return 1;
+    }
+    GeoJSONFaceWriter<T>* geoJSONWriter = outputIsGeoJSON ? new GeoJSONFaceWriter<T>(out, dualOutput) : NULL;
+    WKTFaceWriter<T>* wktWriter = outputIsGeoJSON ? NULL : new WKTFaceWriter<T>(out);
+
+    int workers = streamThreads>0 ? streamThreads : max(1u, thread::hardware_concurrency());
+    //a worker may run at most window polygons ahead of the writer, which bounds the polygons waiting to be written
+    long long window = 2*workers;
+    BoundedQueue<StreamedPolygon> parsed(2*workers), decomposed(window);
+    atomic<long long> written(0);
+
+    vector<thread> workerThreads;
+    for(int w = 0; w<workers; w++)  {
+        workerThreads.push_back(thread([&, w]()  {
+            traceRecorder.nameThread("worker "+to_string(w+1));
+            while(true)  {
+                StreamedPolygon polygon = parsed.pop();
+                if(polygon.index<0)
+                    break;
+                int attempt = 0;
+                while(polygon.index>=written.load(memory_order_acquire)+window)
+                    queueBackoff(attempt);
+                TraceSpan span("polygon", "index", polygon.index);
+                span.setArgument("vertices", polygon.ring.size());
+                vector<Vertex<T>*> vertices;
+                vector<Edge<T>*> edges;
+                //vertices keep the position they had in the input ring, whatever the pre-pass dropped
+                for(int i: simplifiedPositions(polygon.ring))
+                    appendPolygonVertex(vertices, edges, "v"+to_string(i), polygon.ring[i]);
+                polygon.decomposition = decomposePolygon(vertices, edges);
+                freeDCEL(new DCEL<T>(vertices, edges));
+                decomposed.push(move(polygon));
+            }
+        }));
+    }
+
+    thread writer([&]()  {
+        traceRecorder.nameThread("writer");
+        map<long long, StreamedPolygon> waiting;
+        while(true)  {
+            StreamedPolygon polygon = decomposed.pop();
+            if(polygon.index<0)
+                break;
+            waiting[polygon.index] = move(polygon);
+            //write everything that is now in order
+            while(!waiting.empty() && waiting.begin()->first==written.load(memory_order_relaxed))  {
+                StreamedPolygon &next = waiting.begin()->second;
+                TraceSpan span("output", "index", next.index);
+                if(svgOutput)  {
+                    vector<Vertex<T>*> vertices;
+                    vector<Edge<T>*> edges;
+                    for(int i = 0; i<next.ring.size(); i++)
+                        appendPolygonVertex(vertices, edges, "v"+to_string(i), next.ring[i]);
+                    DCEL<T>* original = new DCEL<T>(vertices, edges);
+                    ofstream svg("../Visualisations/polygon"+to_string(next.index)+".svg");
+                    writeDecompositionSVG(svg, original, next.decomposition, svgColoured);
+                    freeDCEL(original);
                 }
-                //fout<<"922\n";
-                //fout.flush();
-                if(polygonCompare(partitionPolygon, firstPolygonPartition))
-                    s++;
+                if(geoJSONWriter)
+                    geoJSONWriter->write(next.decomposition, next.index);
                 else
-                    newFirstPolygon=true;
-                deepCopy(vertices, edges, verticesConst, edgesConst);
+                    wktWriter->write(next.decomposition);
+                freeDCEL(next.decomposition);
+                waiting.erase(waiting.begin());
+                written.fetch_add(1, memory_order_release);
             }
-            //fout<<"928\n";
-            //fout.flush();
         }
-        //fout<<"932\n";
-        //fout.flush();
+    });
+
+    long long polygons = 0;
+    auto onPolygon = [&](vector<Point> &ring)  {
+        StreamedPolygon polygon;
+        polygon.index = polygons++;
+        polygon.ring = ring;
+        parsed.push(move(polygon));
+    };
+    bool isParsed;
+    //the reader runs on this thread, its span includes the time spent waiting for room in the queue
+    TraceSpan readSpan("load");
+    if(inputIsGeoJSON)  {
+        GeoJSONPolygonReader<T> reader(in, onPolygon);
+        isParsed = reader.read();
+    }
+    else  {
+        WKTPolygonReader<T> reader(in, onPolygon);
+        isParsed = reader.read();
+    }
+    readSpan.setArgument("polygons", polygons);
+    readSpan.end();
+
+    //one stop marker per worker, then one for the writer once every worker is done
+    for(int w = 0; w<workers; w++)
+        parsed.push(StreamedPolygon());
+    for(auto &worker: workerThreads)
+        worker.join();
+    decomposed.push(StreamedPolygon());
+    writer.join();
+
+    if(geoJSONWriter)  {
+        geoJSONWriter->close();
+        delete geoJSONWriter;
+    }
+    else  {
+        wktWriter->close();
+        delete wktWriter;
+    }
+    if(!isParsed)
+        cerr<<"Stopped at a syntax error in "<<inputFile<<" after "<<polygons<<" polygons\n";
+    return isParsed ? 0 : 1;
+}
+
+/**
+ * @brief Decomposes the polygons of a GeoJSON or WKT file as the parcels of one planar subdivision
+ * @brief Time is that of decomposePolygon summed over the parcels, divided among the workers, plus O(V + E) expected
+ * time to build the result; O(V + E) space where V is the number of unique vertices and E the number of half edges
+ *
+ * The parcels are read onto a shared vertex table (PlanarSubdivision), decomposed independently by streamThreads workers
+ * on their own vertices (rectilinear parcels into convex pieces as well, as rectangles would add vertices on the shared
+ * boundaries) and their faces rebuilt as one DCEL, whose edges along the boundaries between parcels are twins as much as
+ * the diagonals. Unlike decomposeStream the whole layer is held in memory, once per unique vertex.
+ * @param inputFile path of the input file
+ * @param inputIsGeoJSON true for GeoJSON input, false for WKT
+ * @param outputFile path of the output file, the faces tagged with their parcel
+ * @param outputIsGeoJSON true for GeoJSON output, false for WKT
+ * @return 0 on success, 1 if a file could not be opened or parsed
+ */
+
+int decomposeSubdivision(string inputFile, bool inputIsGeoJSON, string outputFile, bool outputIsGeoJSON)  {
+    ifstream in(inputFile);
+    ofstream out(outputFile);
+    if(!in || !out)  {
+        cerr<<"Could not open "<<(in ? outputFile : inputFile)<<"\n";
+        return 1;
+    }
+    PlanarSubdivision<T> subdivision;
+    auto onPolygon = [&](vector<Point> &ring)  {
+        subdivision.addRing(ring);
+    };
+    bool isParsed;
+    TraceSpan readSpan("load");
+    if(inputIsGeoJSON)  {
+        GeoJSONPolygonReader<T> reader(in, onPolygon);
+        isParsed = reader.read();
+    }
+    else  {
+        WKTPolygonReader<T> reader(in, onPolygon);
+        isParsed = reader.read();
+    }
+    readSpan.setArgument("polygons", subdivision.size());
+    readSpan.setArgument("vertices", subdivision.vertexCount());
+    readSpan.end();
+
+    //faces of every parcel as clockwise runs of shared vertex indices
+    int parcels = subdivision.size();
+    vector<vector<vector<int>>> parcelFaces(parcels);
+    atomic<int> nextParcel(0);
+    auto decomposeParcels = [&]()  {
+        for(int p = nextParcel++; p<parcels; p = nextParcel++)  {
+            if(subdivision.end(p)-subdivision.begin(p)<3)
+                continue;
+            TraceSpan span("parcel", "index", p);
+            span.setArgument("vertices", subdivision.end(p)-subdivision.begin(p));
+            vector<Vertex<T>*> vertices;
+            vector<Edge<T>*> edges;
+            //a vertex the pre-pass would drop as collinear may be a corner of the neighbour, so nothing is simplified
+            for(int k = subdivision.begin(p); k<subdivision.end(p); k++)
+                appendPolygonVertex(vertices, edges, to_string(subdivision.getVertex(k)), subdivision.getCoordinate(subdivision.getVertex(k)));
+            DCEL<T>* decomposition = decomposePolygon(vertices, edges, false);
+            for(auto face: decomposition->getFaces())  {
+                vector<int> faceRing;
+                Edge<T>* edge = face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+                do  {
+                    faceRing.push_back(stoi(edge->getOriginVertex()->getId()));
+                    edge = edge->getNextEdge();
+                }while(edge!=fixEdge);
+                parcelFaces[p].push_back(faceRing);
+            }
+            freeDCEL(decomposition);
+            freeDCEL(new DCEL<T>(vertices, edges));
+        }
+    };
+    int workers = streamThreads>0 ? streamThreads : max(1u, thread::hardware_concurrency());
+    vector<thread> workerThreads;
+    for(int w = 1; w<workers; w++)
+        workerThreads.push_back(thread([&, w]()  {
+            traceRecorder.nameThread("worker "+to_string(w+1));
+            decomposeParcels();
+        }));
+    decomposeParcels();
+    for(auto &worker: workerThreads)
+        worker.join();
+
+    TraceSpan buildSpan("build");
+    vector<vector<int>> faces;
+    vector<int> facePolygons;
+    for(int p = 0; p<parcels; p++)
+        for(auto &face: parcelFaces[p])  {
+            faces.push_back(move(face));
+            facePolygons.push_back(p);
+        }
+    parcelFaces.clear();
+    DCEL<T>* decomposition = subdivision.build(faces);
+    buildSpan.setArgument("faces", faces.size());
+    buildSpan.setArgument("shared", subdivision.getSharedEdges());
+    buildSpan.end();
+    if(subdivision.getConflictingEdges())
+        cerr<<subdivision.getConflictingEdges()<<" edges of "<<inputFile<<" are walked the same way by two faces, the parcels overlap there\n";
+
+    TraceSpan outputSpan("output", "faces", faces.size());
+    if(outputIsGeoJSON)  {
+        GeoJSONFaceWriter<T> writer(out, dualOutput);
+        writer.write(decomposition, -1, &facePolygons);
+        writer.close();
+    }
+    else  {
+        WKTFaceWriter<T> writer(out);
+        writer.write(decomposition);
+        writer.close();
+    }
+    if(binaryOutput && !writeDecompositionBinary(decomposition, "../Outputs/subdivision.pdcl", binaryTwins, false))
+        cerr<<"Could not write the binary decomposition of the subdivision\n";
+    outputSpan.end();
+    freeDCEL(decomposition);
+    if(!isParsed)
+        cerr<<"Stopped at a syntax error in "<<inputFile<<" after "<<parcels<<" polygons\n";
+    return isParsed ? 0 : 1;
+}
+
+/**
+ * @brief Checks located points against the half-plane blocks of their faces, one at a time and in batches per face
+ * @brief O(n + m k) time where n is the size of the decomposition, m the number of points and k the size of their faces
+ * @param decomposition decomposition the points were located in
+ * @param xs x coordinates
+ * @param ys y coordinates
+ * @param faceIndices face of each point as returned by FaceLocator::locate, -1 outside
+ * \return number of points inside a face that either kernel puts outside it, each reported on stderr; points within a
+ * float rounding of an edge may legitimately be among them
+ */
+
+int checkLocatedPoints(DCEL<T>* decomposition, const vector<T> &xs, const vector<T> &ys, const vector<int> &faceIndices)  {
+    HalfPlaneBlocks<T> planes(decomposition);
+    //points of every face, to be classified together
+    vector<vector<int>> facePoints(planes.size());
+    for(int i = 0; i<faceIndices.size(); i++)
+        if(faceIndices[i]>=0)
+            facePoints[faceIndices[i]].push_back(i);
+    int disagreements = 0;
+    vector<float> faceXs, faceYs;
+    vector<uint8_t> inside;
+    for(int f = 0; f<planes.size(); f++)  {
+        faceXs.clear();
+        faceYs.clear();
+        for(auto i: facePoints[f])  {
+            faceXs.push_back(xs[i]);
+            faceYs.push_back(ys[i]);
+        }
+        inside.resize(faceXs.size());
+        planes.classifyPoints(f, faceXs.data(), faceYs.data(), faceXs.size(), inside.data());
+        for(int k = 0; k<facePoints[f].size(); k++)
+            if(!inside[k] || !planes.containsPoint(f, faceXs[k], faceYs[k]))  {
+                cerr<<"Point "<<faceXs[k]<<" "<<faceYs[k]<<" located in face "<<planes.getFaceId(f)<<" is outside its half-planes\n";
+                disagreements++;
+            }
+    }
+    cerr<<"Location check: "<<disagreements<<" of "<<faceIndices.size()<<" points disagree with the half-plane kernels\n";
+    return disagreements;
+}
+
+/**
+ * @brief Locates a file of "x y" points in the decomposition and writes the id of the face holding each, -1 outside
+ * @brief O(n + m k) time where n is the size of the decomposition, m the number of points and k the size of the faces tested per point
+ * @param decomposition decomposition
+ * @param inputFile points, one per line
+ * @param outputFile face ids, one per line in the order of the points
+ * \return none
+ */
+
+void locatePoints(DCEL<T>* decomposition, string inputFile, string outputFile)  {
+    TraceSpan span("locate");
+    vector<T> xs, ys;
+    ifstream in(inputFile);
+    T x, y;
+    while(in>>x>>y)  {
+        xs.push_back(x);
+        ys.push_back(y);
+    }
+    FaceLocator<T> locator(decomposition);
+    vector<int> faceIndices(xs.size());
+    locator.locateBatch(xs.data(), ys.data(), xs.size(), faceIndices.data());
+    ofstream out(outputFile);
+    for(auto f: faceIndices)
+        out<<(f<0 ? -1 : locator.getFaceId(f))<<"\n";
+    if(checkLocations)
+        checkLocatedPoints(decomposition, xs, ys, faceIndices);
+}
+
+/**
+ * @brief Answers a file of "x1 y1 x2 y2" path queries over the decomposition, used as a navigation mesh
+ * @brief O(n + q F log F / t) time where n is the size of the decomposition, q the number of queries, F the number of
+ * faces and t the number of threads (--threads)
+ * @param decomposition decomposition
+ * @param inputFile queries, one per line
+ * @param outputFile one line per query in the order of the queries- the length of the path, its number of corners k
+ * and the k corners "x y" from start to goal, or -1 when an end lies outside the polygon
+ * \return none
+ */
+
+void answerPathQueries(DCEL<T>* decomposition, string inputFile, string outputFile)  {
+    TraceSpan span("paths");
+    vector<Point> starts, goals;
+    ifstream in(inputFile);
+    T x1, y1, x2, y2;
+    while(in>>x1>>y1>>x2>>y2)  {
+        starts.push_back({x1, y1});
+        goals.push_back({x2, y2});
+    }
+    span.setArgument("queries", starts.size());
+    NavigationMesh<T> mesh(decomposition);
+    vector<vector<Point>> paths;
+    mesh.findPaths(starts, goals, paths, streamThreads>0 ? streamThreads : max(1u, thread::hardware_concurrency()));
+    ofstream out(outputFile);
+    for(auto &path: paths)  {
+        if(path.empty())  {
+            out<<"-1\n";
+            continue;
+        }
+        out<<NavigationMesh<T>::pathLength(path)<<" "<<path.size();
+        for(auto &corner: path)
+            out<<" "<<corner.first<<" "<<corner.second;
+        out<<"\n";
+    }
+}
+
+/**
+ * @brief Writes the dual graph of the decomposition, for every face the faces sharing an edge with it and the shared segment
+ * @brief O(E) expected time where E is the number of half edges of the decomposition
+ * @param decomposition decomposition
+ * @param outputFile "Face <id>: <d> neighbours" per face, then one "<neighbour id> <x1> <y1> <x2> <y2>" line per
+ * neighbour with the shared segment walked clockwise around the face
+ * \return none
+ */
+
+void writeDualGraph(DCEL<T>* decomposition, string outputFile)  {
+    TraceSpan span("dual");
+    DualGraph<T> dual(decomposition);
+    ofstream out(outputFile);
+    for(int f = 0; f<dual.size(); f++)  {
+        out<<"Face "<<dual.getFaceId(f)<<": "<<dual.end(f)-dual.begin(f)<<" neighbours\n";
+        for(int k = dual.begin(f); k<dual.end(f); k++)  {
+            Point from = dual.getPortalFrom(k), to = dual.getPortalTo(k);
+            out<<dual.getFaceId(dual.getNeighbour(k))<<" "<<from.first<<" "<<from.second<<" "<<to.first<<" "<<to.second<<"\n";
+        }
+        out<<"\n";
+    }
+}
+
+/**
+ * @brief Reads vertex edits, one per line- "move id x y", "insert afterId newId x y" or "delete id"
+ * @brief O(m) time and space where m is the number of edits
+ * @param fileName edit file
+ * @return the edits in file order, malformed lines are reported and skipped
+ */
+
+vector<PolygonEdit> readPolygonEdits(string fileName)  {
+    vector<PolygonEdit> edits;
+    ifstream in(fileName);
+    string text;
+    int lineNumber = 0;
+    while(getline(in, text))  {
+        lineNumber++;
+        stringstream fields(text);
+        string kind;
+        if(!(fields>>kind))
+            continue;
+        PolygonEdit edit;
+        bool isValid = false;
+        if(kind=="move")  {
+            edit.type = MOVE_VERTEX;
+            isValid = (bool)(fields>>edit.id>>edit.coordinate.first>>edit.coordinate.second);
+        }
+        else if(kind=="insert")  {
+            edit.type = INSERT_VERTEX;
+            isValid = (bool)(fields>>edit.id>>edit.newId>>edit.coordinate.first>>edit.coordinate.second);
+        }
+        else if(kind=="delete")  {
+            edit.type = DELETE_VERTEX;
+            isValid = (bool)(fields>>edit.id);
+        }
+        if(isValid)
+            edits.push_back(edit);
+        else
+            cerr<<"Ignoring malformed edit on line "<<lineNumber<<" of "<<fileName<<"\n";
+    }
+    return edits;
+}
+
+/**
+ * @brief Applies edits one at a time to a finished decomposition and prints the timing of each and the final decomposition
+ * @brief O(m r^4) time where m is the number of edits and r the size of the largest region an edit touches
+ * @param decomposition decomposition to update, taken over by the incremental decomposition
+ * @param edits edits in order
+ * \return none
+ */
+
+void applyPolygonEdits(DCEL<T>* decomposition, vector<PolygonEdit> &edits)  {
+    //each region is re-decomposed quietly, only the edits are reported
+    bool wasPrintingSteps = printSteps;
+    printSteps = false;
+    IncrementalDecomposition incremental(decomposition);
+    for(int k = 0; k<edits.size(); k++)  {
+        TraceSpan span("edit", "edit", k+1);
+        auto start = chrono::steady_clock::now();
+        bool isApplied = incremental.applyEdit(edits[k]);
+        auto stop = chrono::steady_clock::now();
+        fout<<"Edit "<<k+1<<": "<<(isApplied ? "applied" : "rejected")<<"\tTime taken:  "<<chrono::duration_cast<chrono::microseconds>(stop - start).count()<<" microseconds\n";
+    }
+    printSteps = wasPrintingSteps;
+    fout<<"\n";
+    printDecompositon(incremental.getDecomposition());
+}
+
+/**
+ * @brief Reads the runtime options from the command line
+ * @brief O(argc) time, O(1) space
+ */
+
+void parseArguments(int argc, char* argv[])  {
+    for(int i = 1; i<argc; i++)  {
+        string argument = argv[i];
+        if(argument=="--binary")
+            binaryOutput = true;
+        else if(argument=="--no-twins")
+            binaryTwins = false;
+        else if(argument=="--quiet")
+            printSteps = false;
+        else if((argument=="--geojson-in" || argument=="--wkt-in") && i+1<argc)  {
+            streamInput = argv[++i];
+            streamInputIsGeoJSON = argument=="--geojson-in";
+        }
+        else if((argument=="--geojson-out" || argument=="--wkt-out") && i+1<argc)  {
+            streamOutput = argv[++i];
+            streamOutputIsGeoJSON = argument=="--geojson-out";
+        }
+        else if(argument=="--subdivision")
+            subdivisionInput = true;
+        else if(argument=="--svg" || argument=="--svg-plain")  {
+            svgOutput = true;
+            svgColoured = argument=="--svg";
+        }
+        else if(argument=="--edits" && i+1<argc)
+            editsInput = argv[++i];
+        else if(argument=="--locate" && i+1<argc)
+            locateInput = argv[++i];
+        else if(argument=="--check-locate")
+            checkLocations = true;
+        else if(argument=="--paths" && i+1<argc)
+            pathsInput = argv[++i];
+        else if(argument=="--dual")
+            dualOutput = true;
+        else if(argument=="--threads" && i+1<argc)
+            streamThreads = atoi(argv[++i]);
+        else if(argument=="--memo")
+            memoizeRemainders = true;
+        else if(argument=="--no-rectangles")
+            rectangleEngine = false;
+        else if(argument=="--no-fast-path")
+            fastPaths = false;
+        else if(argument=="--exact" && i+1<argc)
+            exactNotchLimit = max(0, atoi(argv[++i]));
+        else if(argument=="--trace" && i+1<argc)
+            traceOutput = argv[++i];
+        else if(argument=="--simplify")
+            simplifyTolerance = max(simplifyTolerance, 0.0);
+        else if(argument=="--tolerance" && i+1<argc)
+            simplifyTolerance = max(0.0, atof(argv[++i]));
+        else if(argument=="--split" && i+1<argc)
+            splitPieces = atoi(argv[++i]);
+        else if(argument=="--keep" && i+1<argc)
+            keepDecompositions = max(1, atoi(argv[++i]));
+        else if(argument=="--max-vertices" && i+1<argc)
+            maxFaceVertices = max(3, atoi(argv[++i]));
+        else if(argument=="--face-records")
+            faceRecordOutput = true;
+        else
+            cerr<<"Ignoring unknown option "<<argument<<"\n";
+    }
+    //every face of the records has to fit in one of them
+    if(faceRecordOutput && (!maxFaceVertices || maxFaceVertices>FACE_RECORD_VERTICES))
+        maxFaceVertices = FACE_RECORD_VERTICES;
+}
+
+// drivers that reuse the decomposition (benchmarks, bindings) define POLYGON_DECOMPOSITION_LIBRARY before including this file
+#ifndef POLYGON_DECOMPOSITION_LIBRARY
+/**
+ * @brief program to convert a given "polygon" into a set of convex polygons without introducing additional vertices
+ * @brief Worst Case Time Complexity- O(n^4) where n is the number of vertices in the original polygon
+ * @brief Worst Case Space Complexity- O(n^2) where n is the number of vertices in the original polygon
+ */
+// program to convert a given "polygon" into a set of convex polygons without introducing additional vertices
+int main(int argc, char* argv[])  {
+    parseArguments(argc, argv);
+    if(!traceOutput.empty())  {
+        traceRecorder.start();
+        traceRecorder.nameThread("main");
+    }
+    if(!streamInput.empty())  {
+        //streamed polygons are never traced step by step
+        printSteps = false;
+        if(streamOutput.empty())  {
+            streamOutputIsGeoJSON = streamInputIsGeoJSON;
+            streamOutput = streamInputIsGeoJSON ? "../Outputs/output.geojson" : "../Outputs/output.wkt";
+        }
+        int status = subdivisionInput ? decomposeSubdivision(streamInput, streamInputIsGeoJSON, streamOutput, streamOutputIsGeoJSON)
+                                      : decomposeStream(streamInput, streamInputIsGeoJSON, streamOutput, streamOutputIsGeoJSON);
+        if(!traceOutput.empty() && !traceRecorder.write(traceOutput))
+            cerr<<"Could not write "<<traceOutput<<"\n";
+        return status;
+    }
+    for(int i = 1; i<=1; i++)  {
+        local(i);
+
+        auto start = chrono::steady_clock::now();
+        TraceSpan loadSpan("load");
+        // input format
+        /*
+        First line contains an integer n representing the number of vertices in the polygon.
+        The next n lines contains vertices(3 things, i.e vertex_id x_coord y_coord)
+        connected in a clockwise fashion. Coordinate and id both should be unique
+        Eg:
+        5
+        A 0 0
+        B 0 6
+        C 3 3
+        D 6 6
+        E 6 0
+
+        The edges are A-B-C-D-E-A
+        */
+        TextPolygonReader<T> reader(fin);
+        if(!reader.read())
+            cerr<<"Input "<<i<<" is malformed, using the "<<reader.size()<<" vertices read\n";
+        if(reader.getDuplicateIds())
+            cerr<<"Input "<<i<<" repeats "<<reader.getDuplicateIds()<<" vertex ids\n";
+        int numberOfVertices = reader.size();
+        vector<Vertex<T>*> verticesConst;
+        vector<Edge<T>*> edgesConst;
+        //take input and store all the vertices and edges
+        //Theta(n)
+
+        vector<Point> ring;
+        for(int i = 0; i<numberOfVertices; i++)
+            ring.push_back(reader.getCoordinate(i));
+        //the kept vertices carry their original ids, so the faces are reported in the input labels
+        vector<int> positions = simplifiedPositions(ring);
+        for(int i: positions)  {
+            appendPolygonVertex(verticesConst, edgesConst, string(reader.getId(i)), reader.getCoordinate(i));
+        }
+        if(simplifyTolerance>=0)
+            fout<<"Simplified to "<<positions.size()<<" of "<<numberOfVertices<<" vertices\n";
+        // saving the polygon in a dcel, and now operating on copies of it
+        Face<T>* face = new Face<T>(1, edgesConst[0]);
+        vector<Face<T>*> faces;
+        faces.push_back(face);
+        DCEL<T>* originalPolygon = new DCEL<T>(verticesConst, edgesConst, faces);
+
+        loadSpan.setArgument("vertices", verticesConst.size());
+        loadSpan.end();
+
+        fout<<"Original Polygon:\n";
+        printPolygon(edgesConst[0]);
+
+        //edits need a decomposition on the polygon's own vertices
+        vector<DCEL<T>*> bestDecompositions = decomposePolygonBest(verticesConst, edgesConst, keepDecompositions, editsInput.empty());
+        DCEL<T>* minimalPolygonDecomposition = bestDecompositions[0];
+        TraceSpan outputSpan("output", "faces", minimalPolygonDecomposition->getFaces().size());
         //output format
         /*
         construct a "graph" using a typical implementation to be passed to the visualiser
@@ -1190,10 +3762,15 @@ int main()  {
         // convertDCELtoGraph(originalPolygon, adjacencyMatrixOriginal, vertexListOriginal);
         // printGraph(vertexListOriginal, adjacencyMatrixOriginal);
 
+        //the O(n^2) matrix is only needed by visualise.py, which --svg replaces
         vector<Point> vertexList;
         vector<vector<int>> adjacencyMatrix;
-        convertDCELtoGraph(*minimalPolygonDecomposition.begin(), adjacencyMatrix, vertexList);
-        printGraph(vertexList, adjacencyMatrix);
+        if(svgOutput)
+            printDecompositionGraph(minimalPolygonDecomposition);
+        else  {
+            convertDCELtoGraph(minimalPolygonDecomposition, adjacencyMatrix, vertexList);
+            printGraph(vertexList, adjacencyMatrix);
+        }
         // fin.close();
         // fout.close();
         // fout.open("../Outputs/TvsN.txt", ios_base::app);
@@ -1206,10 +3783,44 @@ int main()  {
         fin.close();
         fout.close();
         //visualise(originalPolygon->getVertices(), adjacencyMatrixOriginal, i);
-        visualise((*minimalPolygonDecomposition.begin())->getVertices(), adjacencyMatrix, i);
+        if(!svgOutput)
+            visualise(minimalPolygonDecomposition->getVertices(), adjacencyMatrix, i);
+        else  {
+            ofstream svg("../Visualisations/visualisationDemo"+fileNumber(i)+"_ans.svg");
+            writeDecompositionSVG(svg, originalPolygon, minimalPolygonDecomposition, svgColoured);
+        }
+        if(binaryOutput && !writeDecompositionBinary(minimalPolygonDecomposition, "../Outputs/outputDemo"+fileNumber(i)+".pdcl", binaryTwins, true))
+            cerr<<"Could not write the binary decomposition of input "<<i<<"\n";
+        if(faceRecordOutput && !writeFaceRecords(minimalPolygonDecomposition, "../Outputs/outputDemo"+fileNumber(i)+".pfr"))
+            cerr<<"Could not write the face records of input "<<i<<"\n";
+        if(bestDecompositions.size()>1)  {
+            fout.open("../Outputs/outputDemo"+fileNumber(i)+"_alternatives.txt");
+            for(int k = 1; k<bestDecompositions.size(); k++)  {
+                fout<<"Alternative "<<k<<": "<<bestDecompositions[k]->getFaces().size()<<" faces\n";
+                printDecompositon(bestDecompositions[k]);
+            }
+            fout.close();
+        }
+        outputSpan.end();
+        if(!locateInput.empty())
+            locatePoints(minimalPolygonDecomposition, locateInput, "../Outputs/outputDemo"+fileNumber(i)+"_locations.txt");
+        if(!pathsInput.empty())
+            answerPathQueries(minimalPolygonDecomposition, pathsInput, "../Outputs/outputDemo"+fileNumber(i)+"_paths.txt");
+        if(dualOutput)
+            writeDualGraph(minimalPolygonDecomposition, "../Outputs/outputDemo"+fileNumber(i)+"_dual.txt");
+        //the edits update the decomposition in place, so they come last
+        if(!editsInput.empty())  {
+            vector<PolygonEdit> edits = readPolygonEdits(editsInput);
+            fout.open("../Outputs/outputDemo"+fileNumber(i)+"_edits.txt");
+            applyPolygonEdits(minimalPolygonDecomposition, edits);
+            fout.close();
+        }
 
         // runPythonScript(i);
     }
+    if(!traceOutput.empty() && !traceRecorder.write(traceOutput))
+        cerr<<"Could not write "<<traceOutput<<"\n";
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,836 @@
+/*
+Header File polygonFormats.h
+usage- #include "polygonFormats.h" (after dcel.h and dualGraph.h)
+
+Readers and writers for the polygon file formats.
+TextPolygonReader parses the input_format.txt layout (count, then id x y) from large blocks.
+The GeoJSON and WKT readers hand every polygon to a callback as soon as its geometry is closed, so only
+one geometry is held in memory at a time whatever the size of the FeatureCollection.
+*/
+
+/**
+
+*@file polygonFormats.h
+*@brief Text, GeoJSON and WKT readers feeding the clockwise vertex list used by the decomposition, and GeoJSON, WKT and SVG writers emitting the convex faces.
+
+*/
+
+#ifndef POLYGON_FORMATS_H
+#define POLYGON_FORMATS_H
+
+/**
+ * @brief Keeps only the outer ring of a polygon, drops the repeated closing point and makes it clockwise
+ * @brief O(n) time and O(1) extra space
+ * @param ring coordinates of the ring as read from the file
+ * @return the ring in the orientation expected by the decomposition
+ */
+template <class C>
+vector<pair<C,C>> normaliseRing(vector<pair<C,C>> ring)  {
+    if(ring.size()>1 && ring.front()==ring.back())
+        ring.pop_back();
+    //shoelace, positive for anticlockwise rings
+    double area = 0;
+    for(int i = 0; i<ring.size(); i++)  {
+        pair<C,C> a = ring[i], b = ring[(i+1)%ring.size()];
+        area += (double)a.first*b.second-(double)b.first*a.second;
+    }
+    if(area>0)
+        reverse(ring.begin(), ring.end());
+    return ring;
+}
+
+/**
+ * @class PolygonStreamTokenizer
+ * @brief Block buffered character source shared by the GeoJSON and WKT readers
+ */
+class PolygonStreamTokenizer  {
+private:
+    istream &in;
+    vector<char> buffer;
+    size_t position = 0;
+    size_t filled = 0;
+
+    bool refill()  {
+        in.read(buffer.data(), buffer.size());
+        filled = in.gcount();
+        position = 0;
+        return filled>0;
+    }
+
+public:
+    /**
+     * @brief Wraps the stream, reading it in blocks of blockSize bytes
+     */
+    PolygonStreamTokenizer(istream &in, size_t blockSize = 1<<16) : in(in), buffer(blockSize)  {
+
+    }
+
+    /**
+     * @brief Returns the next character without consuming it, EOF at the end of the stream
+     */
+    int peek()  {
+        if(position==filled && !refill())
+            return EOF;
+        return (unsigned char)buffer[position];
+    }
+
+    /**
+     * @brief Consumes and returns the next character, EOF at the end of the stream
+     */
+    int get()  {
+        int c = peek();
+        if(c!=EOF)
+            position++;
+        return c;
+    }
+
+    /**
+     * @brief Skips whitespace and returns the next character without consuming it
+     */
+    int peekToken()  {
+        int c = peek();
+        while(c!=EOF && isspace(c))  {
+            position++;
+            c = peek();
+        }
+        return c;
+    }
+
+    /**
+     * @brief Consumes the next non whitespace character if it equals expected
+     */
+    bool accept(char expected)  {
+        if(peekToken()==expected)  {
+            position++;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Reads a number in JSON/WKT syntax
+     */
+    bool readNumber(double &value)  {
+        peekToken();
+        string text;
+        int c = peek();
+        while(c!=EOF && (isdigit(c) || c=='-' || c=='+' || c=='.' || c=='e' || c=='E'))  {
+            text.push_back(c);
+            position++;
+            c = peek();
+        }
+        if(text.empty())
+            return false;
+        value = strtod(text.c_str(), NULL);
+        return true;
+    }
+
+    /**
+     * @brief Reads a bare word (WKT keywords, JSON literals)
+     */
+    string readWord()  {
+        peekToken();
+        string word;
+        int c = peek();
+        while(c!=EOF && (isalnum(c) || c=='_'))  {
+            word.push_back(toupper(c));
+            position++;
+            c = peek();
+        }
+        return word;
+    }
+
+    /**
+     * @brief Reads a JSON string, the opening quote must be next
+     */
+    bool readString(string &value)  {
+        if(!accept('"'))
+            return false;
+        value.clear();
+        int c = get();
+        while(c!=EOF && c!='"')  {
+            if(c=='\\')  {
+                c = get();
+                if(c=='u')  {
+                    //ids and types are ascii, keep escaped code points as they are
+                    value += "\\u";
+                    c = get();
+                }
+            }
+            value.push_back(c);
+            c = get();
+        }
+        return c=='"';
+    }
+};
+
+/**
+ * @class TextPolygonReader
+ * @brief Buffer based parser for the input_format.txt layout
+ *
+ * The stream is read in large blocks and tokenised by scanning for whitespace, numbers are converted with
+ * std::from_chars (no locale, no allocation) and ids are interned into one character arena, so a polygon
+ * costs a handful of allocations instead of one string per vertex.
+ */
+template <class C>
+class TextPolygonReader  {
+private:
+    istream &in;
+    vector<char> buffer;
+    size_t position = 0;
+    size_t filled = 0;
+    bool isEnd = false;
+    bool internIds;
+
+    string idArena;
+    vector<uint32_t> idOffsets;
+    vector<uint32_t> vertexIds;
+    vector<pair<C,C>> coordinates;
+    long long duplicateIds = 0;
+
+    //open addressing table of interned id numbers with their hashes, empty slots hold UINT32_MAX
+    vector<pair<uint32_t,uint32_t>> internTable;
+
+    /**
+     * @brief Returns the interned number of the id just appended to the arena, interning it if it is new
+     * @brief O(1) expected time
+     */
+    uint32_t intern(uint32_t candidate)  {
+        if(2*(idOffsets.size()-1)>internTable.size())  {
+            //keep the load factor under one half
+            vector<pair<uint32_t,uint32_t>> old(2*internTable.size(), {UINT32_MAX, 0});
+            swap(old, internTable);
+            size_t mask = internTable.size()-1;
+            for(auto entry: old)  {
+                if(entry.first==UINT32_MAX)
+                    continue;
+                size_t slot = entry.second&mask;
+                while(internTable[slot].first!=UINT32_MAX)
+                    slot = (slot+1)&mask;
+                internTable[slot] = entry;
+            }
+        }
+        string_view id = getUniqueId(candidate);
+        uint32_t idHash = hash<string_view>()(id);
+        size_t mask = internTable.size()-1;
+        size_t slot = idHash&mask;
+        while(internTable[slot].first!=UINT32_MAX)  {
+            if(internTable[slot].second==idHash && getUniqueId(internTable[slot].first)==id)
+                return internTable[slot].first;
+            slot = (slot+1)&mask;
+        }
+        internTable[slot] = {candidate, idHash};
+        return candidate;
+    }
+
+    /**
+     * @brief Moves the unread bytes to the front and appends the next block, growing the buffer for huge tokens
+     */
+    bool refill()  {
+        if(isEnd)
+            return false;
+        size_t remaining = filled-position;
+        memmove(buffer.data(), buffer.data()+position, remaining);
+        if(remaining==buffer.size())
+            buffer.resize(2*buffer.size());
+        in.read(buffer.data()+remaining, buffer.size()-remaining);
+        size_t count = in.gcount();
+        if(count==0)
+            isEnd = true;
+        position = 0;
+        filled = remaining+count;
+        return count>0;
+    }
+
+    /**
+     * @brief Same set as isspace in the C locale, without the locale lookup
+     */
+    static bool isBlank(char c)  {
+        return c==' ' || (c>='\t' && c<='\r');
+    }
+
+    /**
+     * @brief Returns the next whitespace separated token as [begin,end), valid until the next call
+     */
+    bool nextToken(const char* &begin, const char* &end)  {
+        while(true)  {
+            while(position<filled && isBlank(buffer[position]))
+                position++;
+            if(position<filled)
+                break;
+            if(!refill())
+                return false;
+        }
+        size_t tokenEnd = position;
+        while(true)  {
+            while(tokenEnd<filled && !isBlank(buffer[tokenEnd]))
+                tokenEnd++;
+            if(tokenEnd<filled || isEnd)
+                break;
+            //token runs into the end of the block, refill moves it to the front
+            size_t scanned = tokenEnd-position;
+            bool isRefilled = refill();
+            tokenEnd = position+scanned;
+            if(!isRefilled)
+                break;
+        }
+        begin = buffer.data()+position;
+        end = buffer.data()+tokenEnd;
+        position = tokenEnd;
+        return true;
+    }
+
+    template <class V>
+    bool nextNumber(V &value)  {
+        const char *begin, *end;
+        if(!nextToken(begin, end))
+            return false;
+        if(*begin=='+')
+            begin++;
+        from_chars_result result = from_chars(begin, end, value);
+        return result.ec==errc() && result.ptr==end;
+    }
+
+public:
+    /**
+     * @brief Creates a reader over the stream, reading blocks of blockSize bytes
+     * @param internIds when false ids are stored as read, skipping the duplicate check (trusted input)
+     */
+    TextPolygonReader(istream &in, size_t blockSize = 1<<20, bool internIds = true) : in(in), buffer(blockSize), internIds(internIds)  {
+
+    }
+
+    /**
+     * @brief Parses the vertex count followed by that many id x y lines
+     * @brief O(n) time, O(n) space for the coordinates and the interned ids
+     * @return false if the count or a vertex is missing or malformed
+     */
+    bool read()  {
+        long long numberOfVertices;
+        if(!nextNumber(numberOfVertices) || numberOfVertices<0)
+            return false;
+        //a bogus count should not reserve gigabytes up front
+        coordinates.reserve(min(numberOfVertices, 1LL<<24));
+        vertexIds.reserve(min(numberOfVertices, 1LL<<24));
+        idOffsets.assign(1, 0);
+        if(internIds)  {
+            size_t tableSize = 16;
+            while(tableSize<2*min(numberOfVertices, 1LL<<24))
+                tableSize *= 2;
+            internTable.assign(tableSize, {UINT32_MAX, 0});
+        }
+
+        for(long long i = 0; i<numberOfVertices; i++)  {
+            const char *begin, *end;
+            if(!nextToken(begin, end))
+                return false;
+            //append the id, then drop it again if the same text was seen before
+            idArena.append(begin, end);
+            idOffsets.push_back(idArena.size());
+            uint32_t candidate = idOffsets.size()-2;
+            uint32_t id = internIds ? intern(candidate) : candidate;
+            if(id!=candidate)  {
+                duplicateIds++;
+                idOffsets.pop_back();
+                idArena.resize(idOffsets.back());
+            }
+            vertexIds.push_back(id);
+
+            pair<C,C> coordinate;
+            if(!nextNumber(coordinate.first) || !nextNumber(coordinate.second))
+                return false;
+            coordinates.push_back(coordinate);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of vertices read
+     */
+    size_t size()  {
+        return coordinates.size();
+    }
+
+    /**
+     * @brief Returns the coordinate of vertex i
+     */
+    pair<C,C> getCoordinate(size_t i)  {
+        return coordinates[i];
+    }
+
+    /**
+     * @brief Returns the id of vertex i, valid as long as the reader
+     */
+    string_view getId(size_t i)  {
+        return getUniqueId(vertexIds[i]);
+    }
+
+    /**
+     * @brief Returns interned id number u
+     */
+    string_view getUniqueId(uint32_t u) const  {
+        return string_view(idArena.data()+idOffsets[u], idOffsets[u+1]-idOffsets[u]);
+    }
+
+    /**
+     * @brief Returns how many vertices repeated an id already used (input ids should be unique)
+     */
+    long long getDuplicateIds()  {
+        return duplicateIds;
+    }
+};
+
+/**
+ * @class GeoJSONPolygonReader
+ * @brief Streams the Polygon and MultiPolygon geometries out of a GeoJSON document
+ *
+ * Works on a bare geometry, a Feature or a FeatureCollection. Only coordinates of the geometry being parsed
+ * are kept, they are handed over when its object closes. Holes are ignored since the decomposition works on
+ * simple polygons.
+ */
+template <class C>
+class GeoJSONPolygonReader  {
+private:
+    /**
+     * @brief Nested coordinate arrays of one geometry, a leaf holds a position
+     */
+    struct CoordinateNode  {
+        vector<CoordinateNode> children;
+        pair<C,C> point;
+        bool isPosition = false;
+    };
+
+    PolygonStreamTokenizer tokens;
+    function<void(vector<pair<C,C>>&)> onPolygon;
+    long long polygonCount = 0;
+
+    bool parseCoordinates(CoordinateNode &node)  {
+        if(!tokens.accept('['))
+            return false;
+        if(tokens.accept(']'))
+            return true;
+        int c = tokens.peekToken();
+        if(c=='[')  {
+            do  {
+                node.children.emplace_back();
+                if(!parseCoordinates(node.children.back()))
+                    return false;
+            } while(tokens.accept(','));
+        }
+        else  {
+            //a position, extra dimensions are skipped
+            node.isPosition = true;
+            double value;
+            int dimension = 0;
+            do  {
+                if(!tokens.readNumber(value))
+                    return false;
+                if(dimension==0)
+                    node.point.first = value;
+                else if(dimension==1)
+                    node.point.second = value;
+                dimension++;
+            } while(tokens.accept(','));
+        }
+        return tokens.accept(']');
+    }
+
+    void emitPolygon(CoordinateNode &polygon)  {
+        if(polygon.children.empty())
+            return;
+        vector<pair<C,C>> ring;
+        for(auto &position: polygon.children[0].children)
+            ring.push_back(position.point);
+        ring = normaliseRing(ring);
+        if(ring.size()<3)
+            return;
+        polygonCount++;
+        onPolygon(ring);
+    }
+
+    bool parseValue()  {
+        int c = tokens.peekToken();
+        if(c=='{')
+            return parseObject();
+        if(c=='[')  {
+            tokens.accept('[');
+            if(tokens.accept(']'))
+                return true;
+            do  {
+                if(!parseValue())
+                    return false;
+            } while(tokens.accept(','));
+            return tokens.accept(']');
+        }
+        if(c=='"')  {
+            string value;
+            return tokens.readString(value);
+        }
+        if(c=='-' || isdigit(c))  {
+            double value;
+            return tokens.readNumber(value);
+        }
+        return !tokens.readWord().empty();
+    }
+
+    bool parseObject()  {
+        tokens.accept('{');
+        string type;
+        CoordinateNode coordinates;
+        bool hasCoordinates = false;
+        if(!tokens.accept('}'))  {
+            do  {
+                string key;
+                if(!tokens.readString(key) || !tokens.accept(':'))
+                    return false;
+                if(key=="type" && tokens.peekToken()=='"')  {
+                    if(!tokens.readString(type))
+                        return false;
+                }
+                else if(key=="coordinates")  {
+                    if(!parseCoordinates(coordinates))
+                        return false;
+                    hasCoordinates = true;
+                }
+                else if(!parseValue())
+                    return false;
+            } while(tokens.accept(','));
+            if(!tokens.accept('}'))
+                return false;
+        }
+        if(hasCoordinates && type=="Polygon")
+            emitPolygon(coordinates);
+        else if(hasCoordinates && type=="MultiPolygon")
+            for(auto &polygon: coordinates.children)
+                emitPolygon(polygon);
+        return true;
+    }
+
+public:
+    /**
+     * @brief Creates a reader over the stream, onPolygon receives every clockwise outer ring
+     */
+    GeoJSONPolygonReader(istream &in, function<void(vector<pair<C,C>>&)> onPolygon) : tokens(in), onPolygon(onPolygon)  {
+
+    }
+
+    /**
+     * @brief Reads the whole document
+     * @return false on a syntax error, polygons before the error have already been handed over
+     */
+    bool read()  {
+        return parseValue();
+    }
+
+    /**
+     * @brief Returns the number of polygons handed over so far
+     */
+    long long getPolygonCount()  {
+        return polygonCount;
+    }
+};
+
+/**
+ * @class WKTPolygonReader
+ * @brief Streams POLYGON and MULTIPOLYGON geometries out of a WKT file, one or more geometries separated by whitespace, ';' or ','
+ *
+ * Z/M coordinates and SRID prefixes are accepted and dropped. Other geometry types are skipped.
+ */
+template <class C>
+class WKTPolygonReader  {
+private:
+    PolygonStreamTokenizer tokens;
+    function<void(vector<pair<C,C>>&)> onPolygon;
+    long long polygonCount = 0;
+
+    bool parseRing(vector<pair<C,C>> &ring)  {
+        if(!tokens.accept('('))
+            return false;
+        do  {
+            double x, y, extra;
+            if(!tokens.readNumber(x) || !tokens.readNumber(y))
+                return false;
+            while(tokens.readNumber(extra));
+            ring.push_back({x, y});
+        } while(tokens.accept(','));
+        return tokens.accept(')');
+    }
+
+    bool parsePolygon()  {
+        if(!tokens.accept('('))
+            return false;
+        vector<pair<C,C>> outer, hole;
+        if(!parseRing(outer))
+            return false;
+        //holes are parsed and dropped one at a time
+        while(tokens.accept(','))  {
+            hole.clear();
+            if(!parseRing(hole))
+                return false;
+        }
+        if(!tokens.accept(')'))
+            return false;
+        outer = normaliseRing(outer);
+        if(outer.size()>=3)  {
+            polygonCount++;
+            onPolygon(outer);
+        }
+        return true;
+    }
+
+    bool skipGroup()  {
+        int depth = 0;
+        do  {
+            int c = tokens.get();
+            if(c==EOF)
+                return false;
+            if(c=='(')
+                depth++;
+            else if(c==')')
+                depth--;
+        } while(depth>0);
+        return true;
+    }
+
+public:
+    /**
+     * @brief Creates a reader over the stream, onPolygon receives every clockwise outer ring
+     */
+    WKTPolygonReader(istream &in, function<void(vector<pair<C,C>>&)> onPolygon) : tokens(in), onPolygon(onPolygon)  {
+
+    }
+
+    /**
+     * @brief Reads every geometry in the stream
+     * @return false on a syntax error, polygons before the error have already been handed over
+     */
+    bool read()  {
+        while(true)  {
+            while(tokens.accept(';') || tokens.accept(','));
+            if(tokens.peekToken()==EOF)
+                return true;
+            string keyword = tokens.readWord();
+            if(keyword=="SRID")  {
+                //SRID=4326;POLYGON(...)
+                double srid;
+                if(!tokens.accept('=') || !tokens.readNumber(srid))
+                    return false;
+                continue;
+            }
+            if(keyword.empty())
+                return false;
+            string modifier = tokens.readWord();
+            if(modifier=="EMPTY")
+                continue;
+            if(!modifier.empty() && tokens.peekToken()!='(')  {
+                if(tokens.readWord()=="EMPTY")
+                    continue;
+                return false;
+            }
+            if(keyword=="POLYGON")  {
+                if(!parsePolygon())
+                    return false;
+            }
+            else if(keyword=="MULTIPOLYGON")  {
+                if(!tokens.accept('('))
+                    return false;
+                do  {
+                    if(!parsePolygon())
+                        return false;
+                } while(tokens.accept(','));
+                if(!tokens.accept(')'))
+                    return false;
+            }
+            else if(!skipGroup())
+                return false;
+        }
+    }
+
+    /**
+     * @brief Returns the number of polygons handed over so far
+     */
+    long long getPolygonCount()  {
+        return polygonCount;
+    }
+};
+
+/**
+ * @brief Collects the coordinates of a face walking its cycle from the incident edge
+ * @brief O(k) time where k is the number of vertices in the face
+ */
+template <class C>
+vector<pair<C,C>> faceRing(Face<C>* face)  {
+    vector<pair<C,C>> ring;
+    Edge<C>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+    do  {
+        ring.push_back(edge->getOriginVertex()->getCoordinate());
+        edge=edge->getNextEdge();
+    }while(edge!=fixEdge);
+    return ring;
+}
+
+/**
+ * @class GeoJSONFaceWriter
+ * @brief Writes convex faces as GeoJSON Polygon features of one FeatureCollection as they are produced
+ *
+ * Rings are written anticlockwise and closed, as RFC 7946 asks for exterior rings.
+ */
+template <class C>
+class GeoJSONFaceWriter  {
+private:
+    ostream &out;
+    bool isFirst = true;
+    bool withNeighbours;
+
+public:
+    /**
+     * @brief Starts the FeatureCollection
+     * @param withNeighbours also give every face the ids of its neighbours and the portals shared with them (see dualGraph.h)
+     */
+    GeoJSONFaceWriter(ostream &out, bool withNeighbours = false) : out(out), withNeighbours(withNeighbours)  {
+        out<<setprecision(numeric_limits<C>::max_digits10);
+        out<<"{\"type\":\"FeatureCollection\",\"features\":[\n";
+    }
+
+    /**
+     * @brief Appends every face of a decomposition, tagged with the index of the input polygon
+     * @brief O(E) time where E is the number of edges of the decomposition, O(k) space for the largest face
+     * @param facePolygons input polygon of every face, for a decomposition spanning several polygons; polygon is not used then
+     */
+    void write(DCEL<C>* decomposition, long long polygon, const vector<int>* facePolygons = NULL)  {
+        vector<Face<C>*> faces = decomposition->getFaces();
+        DualGraph<C>* dual = withNeighbours ? new DualGraph<C>(decomposition) : NULL;
+        for(int f = 0; f<faces.size(); f++)  {
+            vector<pair<C,C>> ring = faceRing(faces[f]);
+            if(!isFirst)
+                out<<",\n";
+            isFirst = false;
+            out<<"{\"type\":\"Feature\",\"properties\":{\"polygon\":"<<(facePolygons ? (*facePolygons)[f] : polygon)<<",\"face\":"<<faces[f]->getId();
+            if(dual)  {
+                out<<",\"neighbours\":[";
+                for(int k = dual->begin(f); k<dual->end(f); k++)
+                    out<<(k>dual->begin(f) ? "," : "")<<dual->getFaceId(dual->getNeighbour(k));
+                out<<"],\"portals\":[";
+                for(int k = dual->begin(f); k<dual->end(f); k++)  {
+                    pair<C,C> from = dual->getPortalFrom(k), to = dual->getPortalTo(k);
+                    out<<(k>dual->begin(f) ? "," : "")<<"[["<<from.first<<","<<from.second<<"],["<<to.first<<","<<to.second<<"]]";
+                }
+                out<<"]";
+            }
+            out<<"},";
+            out<<"\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[";
+            for(int i = ring.size()-1; i>=0; i--)
+                out<<"["<<ring[i].first<<","<<ring[i].second<<"],";
+            out<<"["<<ring.back().first<<","<<ring.back().second<<"]]]}}";
+        }
+        delete dual;
+    }
+
+    /**
+     * @brief Closes the FeatureCollection
+     */
+    void close()  {
+        out<<"\n]}\n";
+        out.flush();
+    }
+};
+
+/**
+ * @class WKTFaceWriter
+ * @brief Writes convex faces as one WKT POLYGON per line, anticlockwise and closed
+ */
+template <class C>
+class WKTFaceWriter  {
+private:
+    ostream &out;
+
+public:
+    /**
+     * @brief Creates a writer over the stream
+     */
+    WKTFaceWriter(ostream &out) : out(out)  {
+        out<<setprecision(numeric_limits<C>::max_digits10);
+    }
+
+    /**
+     * @brief Appends every face of a decomposition
+     * @brief O(E) time where E is the number of edges of the decomposition, O(k) space for the largest face
+     */
+    void write(DCEL<C>* decomposition)  {
+        for(auto face: decomposition->getFaces())  {
+            vector<pair<C,C>> ring = faceRing(face);
+            out<<"POLYGON ((";
+            for(int i = ring.size()-1; i>=0; i--)
+                out<<ring[i].first<<" "<<ring[i].second<<", ";
+            out<<ring.back().first<<" "<<ring.back().second<<"))\n";
+        }
+    }
+
+    /**
+     * @brief Flushes the stream
+     */
+    void close()  {
+        out.flush();
+    }
+};
+
+/**
+ * @brief Fill colour of face number k, hues are spread by the golden angle so neighbours rarely look alike
+ */
+inline string faceColour(long long k)  {
+    double hue = fmod(k*137.50776405, 360.0);
+    char colour[40];
+    snprintf(colour, sizeof(colour), "hsl(%.1f,65%%,72%%)", hue);
+    return colour;
+}
+
+/**
+ * @brief Renders the outline of a polygon and the convex faces of its decomposition as an SVG document
+ * @brief O(V+E) time in one pass over the vertices and one over the face cycles, O(1) extra space
+ * @param out stream receiving the document
+ * @param original polygon that was decomposed, drawn as the outline
+ * @param decomposition decomposition whose faces are drawn
+ * @param isColoured fill every face with its own colour instead of leaving the faces empty
+ * @param width width of the picture in pixels, the height follows the aspect ratio
+ */
+template <class C>
+void writeDecompositionSVG(ostream &out, DCEL<C>* original, DCEL<C>* decomposition, bool isColoured, int width = 1000)  {
+    vector<Vertex<C>*> vertices = original->getVertices();
+    if(vertices.empty())
+        return;
+    double minX = vertices[0]->getCoordinate().first, maxX = minX;
+    double minY = vertices[0]->getCoordinate().second, maxY = minY;
+    for(auto vertex: vertices)  {
+        minX = min(minX, (double)vertex->getCoordinate().first);
+        maxX = max(maxX, (double)vertex->getCoordinate().first);
+        minY = min(minY, (double)vertex->getCoordinate().second);
+        maxY = max(maxY, (double)vertex->getCoordinate().second);
+    }
+    double spanX = max(maxX-minX, 1e-9), spanY = max(maxY-minY, 1e-9);
+    double margin = 0.02*max(spanX, spanY);
+    int height = max(1, (int)(width*spanY/spanX));
+
+    out<<setprecision(numeric_limits<C>::digits10+1);
+    out<<"<svg xmlns=\"http://www.w3.org/2000/svg\" width=\""<<width<<"\" height=\""<<height<<"\" ";
+    out<<"viewBox=\""<<minX-margin<<" "<<-maxY-margin<<" "<<spanX+2*margin<<" "<<spanY+2*margin<<"\">\n";
+    //y grows upwards in the input, downwards in svg
+    out<<"<g transform=\"scale(1,-1)\" stroke-linejoin=\"round\">\n";
+
+    long long k = 0;
+    for(auto face: decomposition->getFaces())  {
+        out<<"<polygon fill=\""<<(isColoured ? faceColour(k++) : "none")<<"\" stroke=\"#333\" stroke-width=\"1\" vector-effect=\"non-scaling-stroke\" points=\"";
+        Edge<C>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            out<<edge->getOriginVertex()->getCoordinate().first<<","<<edge->getOriginVertex()->getCoordinate().second<<" ";
+            edge=edge->getNextEdge();
+        }while(edge!=fixEdge);
+        out<<"\"/>\n";
+    }
+
+    out<<"<polygon fill=\"none\" stroke=\"#000\" stroke-width=\"2.5\" vector-effect=\"non-scaling-stroke\" points=\"";
+    for(auto vertex: vertices)
+        out<<vertex->getCoordinate().first<<","<<vertex->getCoordinate().second<<" ";
+    out<<"\"/>\n</g>\n</svg>\n";
+}
+
+#endif
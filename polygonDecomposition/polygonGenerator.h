@@ -0,0 +1,234 @@
+/*
+Header File polygonGenerator.h
+usage- #include "polygonGenerator.h"
+
+Native generator of valid simple polygons for benchmarking, replacing polygonGenerator.py.
+Every family returns its vertices in clockwise order, as input_format.txt asks for.
+Coordinates are whole numbers kept below 2^23 so they survive the float coordinate type exactly, smooth
+families (star, spiral, near-convex) with hundreds of thousands of vertices still get vertices close to
+collinear once stored as float, the benchmark counts notches on the stored coordinates for that reason.
+*/
+
+/**
+
+*@file polygonGenerator.h
+*@brief Generators for random simple, comb, spiral, star, rectilinear and near-convex polygons of any size.
+
+*/
+
+#ifndef POLYGON_GENERATOR_H
+#define POLYGON_GENERATOR_H
+
+/**
+ * @brief Largest radius used by the round families
+ */
+#define GENERATOR_MAX_RADIUS 4194304.0
+
+/**
+ * @brief Alias for a generated polygon, vertices in clockwise order
+ */
+typedef vector<pair<double,double>> GeneratedPolygon;
+
+/**
+ * @brief Makes a ring clockwise, reversing it if its signed area is positive
+ * @brief O(n) time and O(1) extra space
+ */
+inline void makeClockwise(GeneratedPolygon &ring)  {
+    double area = 0;
+    for(int i = 0; i<ring.size(); i++)  {
+        pair<double,double> a = ring[i], b = ring[(i+1)%ring.size()];
+        area += a.first*b.second-b.first*a.second;
+    }
+    if(area>0)
+        reverse(ring.begin(), ring.end());
+}
+
+/**
+ * @brief Star with alternating outer and inner radius, n/2 notches
+ * @brief O(n) time and space
+ */
+inline GeneratedPolygon generateStar(int n, mt19937 &random)  {
+    GeneratedPolygon ring;
+    uniform_real_distribution<double> jitter(0.9, 1.0);
+    double scale = min(64.0*n, GENERATOR_MAX_RADIUS);
+    for(int i = 0; i<n; i++)  {
+        double angle = -2*M_PI*i/n;
+        double radius = (i%2==0 ? scale : 0.45*scale)*jitter(random);
+        ring.push_back({round(radius*cos(angle)), round(radius*sin(angle))});
+    }
+    return ring;
+}
+
+/**
+ * @brief Random x-monotone polygon, vertices are spread at random over an upper and a lower chain
+ * @brief O(n) time and space
+ *
+ * The upper chain lies strictly above the line joining the two extreme vertices and the lower chain strictly
+ * below it, so the chains never cross and the polygon is simple while notches appear at random on both chains.
+ */
+inline GeneratedPolygon generateRandomSimple(int n, mt19937 &random)  {
+    int height = 1<<20;
+    uniform_int_distribution<int> upper(height/2+1, height), lower(0, height/2-1);
+    bernoulli_distribution isUpper(0.5);
+    GeneratedPolygon top, bottom;
+    top.push_back({0, height/2});
+    for(int i = 1; i<n-1; i++)  {
+        double x = 4.0*i;
+        if(isUpper(random))
+            top.push_back({x, (double)upper(random)});
+        else
+            bottom.push_back({x, (double)lower(random)});
+    }
+    top.push_back({4.0*(n-1), height/2});
+    //along the top from left to right, then back along the bottom is clockwise
+    GeneratedPolygon ring = top;
+    for(int i = bottom.size()-1; i>=0; i--)
+        ring.push_back(bottom[i]);
+    return ring;
+}
+
+/**
+ * @brief Adds extra vertices on an outward bulge of the edge from ring.back() to ring.front() so the size is exactly n
+ * @brief O(n) time, the bulge is convex so no notch is added
+ */
+inline void padWithBulge(GeneratedPolygon &ring, int n)  {
+    int extra = n-ring.size();
+    if(extra<=0)
+        return;
+    pair<double,double> a = ring.back(), b = ring.front();
+    //outward normal of a clockwise edge points to its left
+    double dx = b.first-a.first, dy = b.second-a.second;
+    double length = sqrt(dx*dx+dy*dy);
+    double nx = -dy/length, ny = dx/length;
+    for(int k = 1; k<=extra; k++)  {
+        double t = (double)k/(extra+1);
+        double bulge = 0.25*length*t*(1-t);
+        ring.push_back({round(a.first+t*dx+bulge*nx), round(a.second+t*dy+bulge*ny)});
+    }
+}
+
+/**
+ * @brief Comb, a bar with about n/4 rectangular teeth, every gap between teeth holds two notches
+ * @brief O(n) time and space
+ */
+inline GeneratedPolygon generateComb(int n, mt19937 &random)  {
+    int teeth = max(1, n/4);
+    double width = 16, base = 64;
+    uniform_int_distribution<int> toothHeight(256, 1024);
+    GeneratedPolygon ring;
+    ring.push_back({0, 0});
+    for(int j = 0; j<teeth; j++)  {
+        double height = base+toothHeight(random);
+        ring.push_back({2*j*width, height});
+        ring.push_back({(2*j+1)*width, height});
+        if(j<teeth-1)  {
+            ring.push_back({(2*j+1)*width, base});
+            ring.push_back({(2*j+2)*width, base});
+        }
+    }
+    ring.push_back({(2*teeth-1)*width, 0});
+    //the bar is closed by the bottom edge back to the origin
+    padWithBulge(ring, n);
+    return ring;
+}
+
+/**
+ * @brief Thick spiral band, n/2 vertices on the outer arm and n/2 on the inner arm
+ * @brief O(n) time and space
+ */
+inline GeneratedPolygon generateSpiral(int n, mt19937 &random)  {
+    int half = max(2, n/2);
+    //at least 32 vertices per turn keep the chords of neighbouring arms apart
+    double turns = max(0.25, min(8.0, half/32.0));
+    //the radius grows by 2*pi*growth per turn, the band is narrower than that so the arms never touch
+    double growth = min(64.0*half/turns, GENERATOR_MAX_RADIUS/(2*M_PI*(turns+1))), width = 0.5*2*M_PI*growth, start = 2*width;
+    uniform_real_distribution<double> jitter(-0.05, 0.05);
+    GeneratedPolygon outer, inner;
+    for(int i = 0; i<half; i++)  {
+        double angle = 2*M_PI*turns*i/(half-1);
+        double radius = start+growth*angle;
+        double outerRadius = radius+width*(1+jitter(random));
+        outer.push_back({round(outerRadius*cos(angle)), round(outerRadius*sin(angle))});
+        inner.push_back({round(radius*cos(angle)), round(radius*sin(angle))});
+    }
+    GeneratedPolygon ring = outer;
+    for(int i = half-1; i>=0; i--)
+        ring.push_back(inner[i]);
+    if(ring.size()<n)
+        ring.insert(ring.begin()+half, {round(outer.back().first*1.01), round(outer.back().second*1.01)});
+    makeClockwise(ring);
+    return ring;
+}
+
+/**
+ * @brief Rectilinear histogram, columns of random height standing on a flat base
+ * @brief O(n) time and space, rectilinear polygons have an even number of vertices so odd n is rounded down
+ */
+inline GeneratedPolygon generateRectilinear(int n, mt19937 &random)  {
+    int columns = max(1, (n-2)/2);
+    double width = 16;
+    uniform_int_distribution<int> heightDistribution(1, 1024);
+    GeneratedPolygon ring;
+    ring.push_back({0, 0});
+    double previous = -1;
+    for(int j = 0; j<columns; j++)  {
+        double height = 16*heightDistribution(random);
+        //equal neighbours would leave collinear vertices
+        while(height==previous)
+            height = 16*heightDistribution(random);
+        ring.push_back({j*width, height});
+        ring.push_back({(j+1)*width, height});
+        previous = height;
+    }
+    ring.push_back({columns*width, 0});
+    return ring;
+}
+
+/**
+ * @brief Regular polygon with about one vertex in twenty pulled inwards into a shallow notch
+ * @brief O(n) time and space
+ */
+inline GeneratedPolygon generateNearConvex(int n, mt19937 &random)  {
+    GeneratedPolygon ring;
+    bernoulli_distribution isNotch(0.05);
+    double radius = min(64.0*n, GENERATOR_MAX_RADIUS);
+    double sagitta = radius*(1-cos(M_PI/n));
+    for(int i = 0; i<n; i++)  {
+        double angle = -2*M_PI*i/n;
+        //pulling a vertex in by more than the sagitta makes it reflex
+        double r = isNotch(random) ? radius-4*sagitta-2 : radius;
+        ring.push_back({round(r*cos(angle)), round(r*sin(angle))});
+    }
+    return ring;
+}
+
+/**
+ * @brief Names of the generated families, in the order the benchmark runs them
+ */
+inline vector<string> polygonFamilies()  {
+    return {"random", "comb", "spiral", "star", "rectilinear", "nearconvex"};
+}
+
+/**
+ * @brief Generates a polygon of the named family with about n vertices
+ * @return the clockwise ring, empty for an unknown family
+ */
+inline GeneratedPolygon generatePolygon(string family, int n, unsigned seed)  {
+    mt19937 random(seed);
+    n = max(n, 4);
+    if(family=="random")
+        return generateRandomSimple(n, random);
+    if(family=="comb")
+        return generateComb(n, random);
+    if(family=="spiral")
+        return generateSpiral(n, random);
+    if(family=="star")
+        return generateStar(n, random);
+    if(family=="rectilinear")
+        return generateRectilinear(n, random);
+    if(family=="nearconvex")
+        return generateNearConvex(n, random);
+    return GeneratedPolygon();
+}
+
+#endif
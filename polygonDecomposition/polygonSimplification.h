@@ -0,0 +1,232 @@
+/*
+Header File polygonSimplification.h
+usage- #include "polygonSimplification.h"
+
+Optional pre-pass shrinking the vertex ring before it is decomposed.
+Digitised outlines and GPS traces carry many vertices lying on a straight run or on top of each other; every one of
+them is another start for the decomposition and another entry in each of its O(n) scans, and the exact zero turn
+they produce leads to degenerate partitions. removeCollinearVertices drops those exactly (the polygon is unchanged),
+simplifyRing additionally runs a Douglas-Peucker pass with a tolerance.
+Both return the positions of the kept vertices in the input ring, so every vertex of the output still carries its
+original label, and the vertices dropped between kept[k] and kept[k+1] all lie on (or within the tolerance of) the
+edge joining them.
+*/
+
+/**
+
+*@file polygonSimplification.h
+*@brief Exact collinear vertex removal and tolerance bounded Douglas-Peucker simplification of a clockwise ring, keeping the original vertex positions.
+
+*/
+
+#ifndef POLYGON_SIMPLIFICATION_H
+#define POLYGON_SIMPLIFICATION_H
+
+/**
+ * @brief Twice the signed area of the triangle a b c, zero when the three points are collinear or two coincide
+ * @brief O(1) time, computed in double so that float coordinates are exact
+ */
+template <class C>
+double ringTurn(const pair<C,C> &a, const pair<C,C> &b, const pair<C,C> &c)  {
+    return ((double)b.first-a.first)*((double)c.second-a.second)-((double)b.second-a.second)*((double)c.first-a.first);
+}
+
+/**
+ * @brief Distance from p to the segment a b
+ * @brief O(1) time
+ */
+template <class C>
+double segmentDistance(const pair<C,C> &p, const pair<C,C> &a, const pair<C,C> &b)  {
+    double dx = (double)b.first-a.first, dy = (double)b.second-a.second;
+    double px = (double)p.first-a.first, py = (double)p.second-a.second;
+    double length = dx*dx+dy*dy;
+    double t = length>0 ? max(0.0, min(1.0, (px*dx+py*dy)/length)) : 0;
+    return hypot(px-t*dx, py-t*dy);
+}
+
+/**
+ * @brief Removes every vertex whose two neighbours are collinear with it, including repeated points and zero width spikes
+ * @brief O(n) time and O(n) space
+ * @param ring vertices of the polygon, in clockwise order
+ * @return positions in ring of the kept vertices, in order; the shape of the polygon is unchanged
+ */
+template <class C>
+vector<int> removeCollinearVertices(const vector<pair<C,C>> &ring)  {
+    int n = ring.size();
+    //kept is the ring built so far, every removal pops one vertex so the loops are O(n) together
+    vector<int> kept;
+    for(int i = 0; i<n; i++)  {
+        while(kept.size()>=2 && ringTurn(ring[kept[kept.size()-2]], ring[kept.back()], ring[i])==0)
+            kept.pop_back();
+        kept.push_back(i);
+    }
+    size_t head = 0;
+    bool isChanged = true;
+    //the turns at the two ends of the run still have to be checked across the seam
+    while(isChanged && kept.size()-head>=3)  {
+        isChanged = false;
+        while(kept.size()-head>=3 && ringTurn(ring[kept[kept.size()-2]], ring[kept.back()], ring[kept[head]])==0)  {
+            kept.pop_back();
+            isChanged = true;
+        }
+        while(kept.size()-head>=3 && ringTurn(ring[kept.back()], ring[kept[head]], ring[kept[head+1]])==0)  {
+            head++;
+            isChanged = true;
+        }
+    }
+    kept.erase(kept.begin(), kept.begin()+head);
+    //a ring without any turn has no area, it is left as it was
+    if(kept.size()<3)  {
+        kept.resize(n);
+        iota(kept.begin(), kept.end(), 0);
+    }
+    return kept;
+}
+
+/**
+ * @brief Checks whether the edges of a ring cross or touch anywhere except between consecutive edges at their shared vertex
+ * @brief O(m log m + k) time where m is the number of vertices and k the number of edge pairs with overlapping x ranges
+ * @param ring all vertices
+ * @param kept positions in ring of the vertices forming the ring to check
+ * @param crossing set to the positions in kept of the two first crossing edges found
+ * @return true if the ring is simple
+ */
+template <class C>
+bool isSimpleRing(const vector<pair<C,C>> &ring, const vector<int> &kept, pair<int,int> &crossing)  {
+    int m = kept.size();
+    vector<int> order(m);
+    iota(order.begin(), order.end(), 0);
+    auto low = [&](int e)  { return min(ring[kept[e]].first, ring[kept[(e+1)%m]].first); };
+    auto high = [&](int e)  { return max(ring[kept[e]].first, ring[kept[(e+1)%m]].first); };
+    sort(order.begin(), order.end(), [&](int e1, int e2)  { return low(e1)<low(e2); });
+    for(int i = 0; i<m; i++)  {
+        int e1 = order[i];
+        const pair<C,C> &a = ring[kept[e1]], &b = ring[kept[(e1+1)%m]];
+        for(int j = i+1; j<m && low(order[j])<=high(e1); j++)  {
+            int e2 = order[j];
+            const pair<C,C> &c = ring[kept[e2]], &d = ring[kept[(e2+1)%m]];
+            if(max(a.second, b.second)<min(c.second, d.second) || max(c.second, d.second)<min(a.second, b.second))
+                continue;
+            double d1 = ringTurn(c, d, a), d2 = ringTurn(c, d, b), d3 = ringTurn(a, b, c), d4 = ringTurn(a, b, d);
+            bool isCrossing;
+            if((e1+1)%m==e2 || (e2+1)%m==e1)  {
+                //consecutive edges meet at their shared vertex, they only clash if the second one folds back along the first
+                double dot = ((double)b.first-a.first)*((double)d.first-c.first)+((double)b.second-a.second)*((double)d.second-c.second);
+                isCrossing = d1==0 && d2==0 && dot<0;
+            }
+            else
+                isCrossing = ((d1<=0 && d2>=0) || (d1>=0 && d2<=0)) && ((d3<=0 && d4>=0) || (d3>=0 && d4<=0))
+                             && !(d1==0 && d2==0 && segmentDistance(a, c, d)>0 && segmentDistance(b, c, d)>0 && segmentDistance(c, a, b)>0 && segmentDistance(d, a, b)>0);
+            if(isCrossing)  {
+                crossing = {e1, e2};
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Simplifies a ring so that no dropped vertex is further than tolerance from the edge replacing it
+ * @brief O(n log n) expected time for Douglas-Peucker, plus O(m log m + k) per round of repairs of crossing edges
+ *
+ * Exactly collinear vertices are removed first. The rest of the ring is split at its first vertex and the vertex
+ * furthest from it, and each half is simplified by Douglas-Peucker with the distance to the replacing segment, so the
+ * Hausdorff distance between the input and the output boundary is at most tolerance. Douglas-Peucker may make two
+ * edges cross; the edges involved are then split again at their furthest dropped vertex until the ring is simple.
+ * If the result would not be a clockwise polygon (the tolerance swallows the whole shape) only the exact removal is kept.
+ * @param ring vertices of the polygon, in clockwise order
+ * @param tolerance largest allowed distance of a dropped vertex from the output boundary, 0 for the exact removal only
+ * @return positions in ring of the kept vertices, in order
+ */
+template <class C>
+vector<int> simplifyRing(const vector<pair<C,C>> &ring, double tolerance)  {
+    vector<int> exact = removeCollinearVertices(ring);
+    int m = exact.size();
+    if(tolerance<=0 || m<=3)
+        return exact;
+
+    //Douglas-Peucker on the exact ring, isKept marks the survivors
+    vector<char> isKept(m+1, 0);
+    int far = 0;
+    double farDistance = 0;
+    for(int i = 1; i<m; i++)  {
+        double d = hypot((double)ring[exact[i]].first-ring[exact[0]].first, (double)ring[exact[i]].second-ring[exact[0]].second);
+        if(d>farDistance)  {
+            farDistance = d;
+            far = i;
+        }
+    }
+    isKept[0] = isKept[far] = isKept[m] = 1;
+    //position m stands for position 0 closing the ring
+    auto at = [&](int i) -> const pair<C,C>&  { return ring[exact[i%m]]; };
+    auto furthest = [&](int first, int last, double &distance)  {
+        int best = -1;
+        distance = -1;
+        for(int i = first+1; i<last; i++)  {
+            double d = segmentDistance(at(i), at(first), at(last));
+            if(d>distance)  {
+                distance = d;
+                best = i;
+            }
+        }
+        return best;
+    };
+    vector<pair<int,int>> stack = {{0, far}, {far, m}};
+    while(!stack.empty())  {
+        pair<int,int> run = stack.back();
+        stack.pop_back();
+        double distance;
+        int split = furthest(run.first, run.second, distance);
+        if(split<0 || distance<=tolerance)
+            continue;
+        isKept[split] = 1;
+        stack.push_back({run.first, split});
+        stack.push_back({split, run.second});
+    }
+
+    vector<int> positions;
+    for(int i = 0; i<m; i++)
+        if(isKept[i])
+            positions.push_back(i);
+    //repair crossings by keeping the furthest dropped vertex of each crossing edge
+    while(positions.size()>=3)  {
+        vector<int> simplified;
+        for(int p: positions)
+            simplified.push_back(exact[p]);
+        pair<int,int> crossing;
+        if(isSimpleRing(ring, simplified, crossing))
+            break;
+        bool isSplit = false;
+        for(int e: {crossing.first, crossing.second})  {
+            int first = positions[e], last = e+1==positions.size() ? m : positions[e+1];
+            double distance;
+            int split = furthest(first, last, distance);
+            if(split>=0)  {
+                isKept[split] = 1;
+                isSplit = true;
+            }
+        }
+        //both edges are original edges, the input itself is not simple
+        if(!isSplit)
+            break;
+        positions.clear();
+        for(int i = 0; i<m; i++)
+            if(isKept[i])
+                positions.push_back(i);
+    }
+
+    vector<int> kept;
+    double area = 0;
+    for(int p: positions)
+        kept.push_back(exact[p]);
+    for(int i = 0; i<kept.size(); i++)  {
+        const pair<C,C> &a = ring[kept[i]], &b = ring[kept[(i+1)%kept.size()]];
+        area += (double)a.first*b.second-(double)b.first*a.second;
+    }
+    if(kept.size()<3 || area>=0)
+        return exact;
+    return kept;
+}
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file pythonBindings.cpp
+ * @brief Python module exposing the decomposition on NumPy arrays, built with pybind11.
+ *
+ * build- python3 setup.py build_ext --inplace (from the repository root, test_pythonBindings.py then checks the module), or
+ *        c++ -O3 -shared -std=c++17 -fPIC -pthread $(python3 -m pybind11 --includes) pythonBindings.cpp \
+ *            -o polygon_decomposition$(python3-config --extension-suffix)
+ *
+ * usage-
+ *     import numpy as np, polygon_decomposition as pd
+ *     ring = np.array([[0, 0], [0, 2], [2, 2], [2, 1], [1, 1], [1, 0]], dtype=np.float32)
+ *     indices, offsets, steiner = pd.decompose(ring)
+ *     faces = [indices[offsets[f]:offsets[f+1]] for f in range(len(offsets)-1)]
+ *
+ * The ring is a C-contiguous (n,2) float32 array and is read in place; any other dtype or layout is converted once
+ * by pybind11 first. Either orientation is accepted. Every face is returned as a run of vertex indices in indices,
+ * face f being indices[offsets[f]:offsets[f+1]] in clockwise order. Index i < n is row i of the input; the
+ * rectangle engine may add vertices where its cuts end, index n+k is row k of steiner. The three arrays hand over
+ * the buffers they were built in, nothing is copied on the way out.
+ * The interpreter lock is released while the polygon is decomposed, so Python threads decompose in parallel.
+ */
+
+//pybind11 comes first, the decomposition defines T and Point as macros
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#define POLYGON_DECOMPOSITION_LIBRARY
+#include "polygonDecomposition_final.cpp"
+
+namespace py = pybind11;
+
+/**
+ * @brief Wraps a vector as a NumPy array owning its buffer, without copying it
+ * @brief O(1) time
+ * @param values moved from
+ * @param shape shape of the array, its product is values.size()
+ */
+template <class V>
+py::array_t<V> toArray(vector<V> &&values, vector<py::ssize_t> shape)  {
+    vector<V>* owned = new vector<V>(move(values));
+    py::capsule owner(owned, [](void* pointer)  { delete (vector<V>*)pointer; });
+    return py::array_t<V>(shape, owned->data(), owner);
+}
+
+/**
+ * @brief Decomposes a simple polygon into convex pieces
+ * @brief O(n) time around the decomposition itself, see decomposePolygon
+ * @param points (n,2) array of the polygon vertices in order, without repeating the first one
+ * @param rectangles false to keep rectilinear polygons on their own vertices, decomposing them into convex pieces
+ * @return (indices, offsets, steiner) as described in the file comment
+ */
+
+py::tuple decompose(py::array_t<float, py::array::c_style | py::array::forcecast> points, bool rectangles)  {
+    if(points.ndim()!=2 || points.shape(1)!=2)
+        throw invalid_argument("points must be an (n,2) array");
+    int n = points.shape(0);
+    if(n<3)
+        throw invalid_argument("a polygon needs at least 3 vertices");
+    auto coordinates = points.unchecked<2>();
+
+    //the decomposition works on clockwise rings, a counter clockwise input is walked backwards
+    double area = 0;
+    for(int i = 0; i<n; i++)  {
+        int j = (i+1)%n;
+        area += (double)coordinates(i, 0)*coordinates(j, 1)-(double)coordinates(j, 0)*coordinates(i, 1);
+    }
+    vector<Vertex<T>*> vertices;
+    vector<Edge<T>*> edges;
+    for(int k = 0; k<n; k++)  {
+        int i = area>0 ? n-1-k : k;
+        appendPolygonVertex(vertices, edges, "v"+to_string(i), {coordinates(i, 0), coordinates(i, 1)});
+    }
+
+    DCEL<T>* decomposition;
+    {
+        py::gil_scoped_release release;
+        decomposition = decomposePolygon(vertices, edges, rectangles);
+        freeDCEL(new DCEL<T>(vertices, edges));
+    }
+
+    vector<int64_t> indices, offsets = {0};
+    vector<float> steiner;
+    unordered_map<string,int64_t> steinerIndex;
+    for(auto face: decomposition->getFaces())  {
+        Edge<T>* edge=face->getIncidentEdge(), *fixEdge = face->getIncidentEdge();
+        do  {
+            Vertex<T>* vertex = edge->getOriginVertex();
+            string id = vertex->getId();
+            if(id[0]=='v')
+                indices.push_back(stoll(id.substr(1)));
+            else  {
+                auto inserted = steinerIndex.insert({id, n+(int64_t)steinerIndex.size()});
+                if(inserted.second)  {
+                    steiner.push_back(vertex->getCoordinate().first);
+                    steiner.push_back(vertex->getCoordinate().second);
+                }
+                indices.push_back(inserted.first->second);
+            }
+            edge=edge->getNextEdge();
+        }while(edge!=fixEdge);
+        offsets.push_back(indices.size());
+    }
+    freeDCEL(decomposition);
+
+    py::ssize_t indexCount = indices.size(), faceCount = offsets.size(), steinerCount = steiner.size()/2;
+    return py::make_tuple(toArray(move(indices), {indexCount}), toArray(move(offsets), {faceCount}),
+                          toArray(move(steiner), {steinerCount, (py::ssize_t)2}));
+}
+
+PYBIND11_MODULE(polygon_decomposition, polygonModule)  {
+    //the step by step trace goes to a shared file, the module only returns results
+    printSteps = false;
+    polygonModule.doc() = "Decomposition of simple polygons into few convex pieces";
+    polygonModule.def("decompose", &decompose, py::arg("points"), py::arg("rectangles") = true,
+               "Decomposes an (n,2) ring into convex faces, returns (indices, offsets, steiner)");
+}
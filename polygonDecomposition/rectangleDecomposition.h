@@ -0,0 +1,429 @@
+/*
+Header File rectangleDecomposition.h
+usage- #include "rectangleDecomposition.h" (after dcel.h)
+
+Minimum partition of a rectilinear polygon (every edge horizontal or vertical) into rectangles.
+A rectangle partition has to cut every notch once. A chord joining two notches along a line ("good" chord) cuts
+both at once, so the fewest rectangles are notches - L + 1 where L is the largest set of good chords that do not
+touch each other. Horizontal good chords only ever meet vertical ones, so L is found from a maximum matching in
+the bipartite graph of meeting chords (Koenig's theorem), built with a sweep and matched by Hopcroft-Karp. The
+chosen chords are drawn, every other notch is cut by extending its horizontal edge to the first edge or chord it
+meets, and the faces of the resulting segments are read off as clockwise rectangles. Unlike the convex
+decomposition the cuts may end inside edges, so the decomposition gets new vertices there; faces keep the points
+on their sides where other cuts end, as straight angles.
+*/
+
+/**
+
+*@file rectangleDecomposition.h
+*@brief Minimum rectangle partition of rectilinear polygons by chord matching and sweep-line ray shooting, built into a DCEL.
+
+*/
+
+#ifndef RECTANGLE_DECOMPOSITION_H
+#define RECTANGLE_DECOMPOSITION_H
+
+/**
+ * @brief Shoots axis-parallel rays at the segments crossing their line, with a sweep along the segments
+ * @brief O((s + q) log s) time and O(s + q) space for s segments and q rays
+ * @param segments segments {x, low, high} standing across the rays, ends included
+ * @param rays rays {x, y, direction}, direction +1 towards increasing x and -1 towards decreasing x
+ * @return for every ray the x where it first meets a segment beyond its own x and the index of that segment, -1 if none
+ */
+template <class C>
+vector<pair<C,int>> shootRays(const vector<array<C,3>> &segments, const vector<array<C,3>> &rays)  {
+    vector<int> byLow(segments.size()), byHigh(segments.size()), byY(rays.size());
+    iota(byLow.begin(), byLow.end(), 0);
+    iota(byHigh.begin(), byHigh.end(), 0);
+    iota(byY.begin(), byY.end(), 0);
+    sort(byLow.begin(), byLow.end(), [&](int a, int b)  { return segments[a][1]<segments[b][1]; });
+    sort(byHigh.begin(), byHigh.end(), [&](int a, int b)  { return segments[a][2]<segments[b][2]; });
+    sort(byY.begin(), byY.end(), [&](int a, int b)  { return rays[a][1]<rays[b][1]; });
+
+    vector<pair<C,int>> hits(rays.size(), {0, -1});
+    //segments whose span holds the current y, by x
+    set<pair<C,int>> active;
+    size_t low = 0, high = 0;
+    for(int r: byY)  {
+        C y = rays[r][1];
+        while(low<byLow.size() && segments[byLow[low]][1]<=y)  {
+            active.insert({segments[byLow[low]][0], byLow[low]});
+            low++;
+        }
+        while(high<byHigh.size() && segments[byHigh[high]][2]<y)  {
+            active.erase({segments[byHigh[high]][0], byHigh[high]});
+            high++;
+        }
+        if(rays[r][2]>0)  {
+            auto hit = active.lower_bound({rays[r][0], INT_MAX});
+            if(hit!=active.end())
+                hits[r] = *hit;
+        }
+        else  {
+            auto hit = active.lower_bound({rays[r][0], INT_MIN});
+            if(hit!=active.begin())
+                hits[r] = *prev(hit);
+        }
+    }
+    return hits;
+}
+
+/**
+ * @brief Lists, for every horizontal chord, the vertical chords it meets, with a sweep along x
+ * @brief O((h + v) log h + k) time and O(h + v + k) space for h horizontal and v vertical chords meeting k times
+ * @param horizontal chords {y, x1, x2} with x1<=x2
+ * @param vertical chords {x, y1, y2} with y1<=y2
+ * @return meets[i] the indices of the vertical chords meeting horizontal chord i, ends included
+ */
+template <class C>
+vector<vector<int>> meetingChords(const vector<array<C,3>> &horizontal, const vector<array<C,3>> &vertical)  {
+    int h = horizontal.size(), v = vertical.size();
+    //{x, kind, chord}: a horizontal chord enters the sweep (kind 0) before the vertical chords at its x1 are looked
+    //up (kind 1) and leaves it (kind 2) after those at its x2
+    vector<tuple<C,int,int>> events;
+    for(int i = 0; i<h; i++)  {
+        events.push_back({horizontal[i][1], 0, i});
+        events.push_back({horizontal[i][2], 2, i});
+    }
+    for(int j = 0; j<v; j++)
+        events.push_back({vertical[j][0], 1, j});
+    sort(events.begin(), events.end());
+    vector<vector<int>> meets(h);
+    //horizontal chords spanning the sweep line, by y
+    set<pair<C,int>> active;
+    for(auto &event: events)  {
+        int kind = get<1>(event), chord = get<2>(event);
+        if(kind==0)
+            active.insert({horizontal[chord][0], chord});
+        else if(kind==2)
+            active.erase({horizontal[chord][0], chord});
+        else
+            for(auto it = active.lower_bound({vertical[chord][1], INT_MIN}); it!=active.end() && it->first<=vertical[chord][2]; it++)
+                meets[it->second].push_back(chord);
+    }
+    return meets;
+}
+
+/**
+ * @brief Finds a maximum set of chords no two of which meet, among horizontal and vertical chords
+ * @brief O((h + v) log h + k sqrt(h + v)) time (Hopcroft-Karp) and O(h + v + k) space for h horizontal and v vertical
+ * chords meeting k times; k is at most h v
+ * @param horizontal chords {y, x1, x2} with x1<=x2
+ * @param vertical chords {x, y1, y2} with y1<=y2
+ * @param isChosenHorizontal set to whether each horizontal chord is in the set
+ * @param isChosenVertical set to whether each vertical chord is in the set
+ */
+template <class C>
+void largestDisjointChords(const vector<array<C,3>> &horizontal, const vector<array<C,3>> &vertical, vector<bool> &isChosenHorizontal, vector<bool> &isChosenVertical)  {
+    int h = horizontal.size(), v = vertical.size();
+    vector<vector<int>> meets = meetingChords(horizontal, vertical);
+
+    //Hopcroft-Karp: each round finds the shortest augmenting path length by a breadth first search from the unmatched
+    //horizontal chords, then augments along as many disjoint paths of that length as it can; O(sqrt(h + v)) rounds
+    vector<int> matchOfHorizontal(h, -1), matchOfVertical(v, -1);
+    vector<int> layer(h), nextMeet(h);
+    auto layerChords = [&]()  {
+        queue<int> pending;
+        for(int i = 0; i<h; i++)  {
+            layer[i] = matchOfHorizontal[i]<0 ? 0 : -1;
+            if(layer[i]==0)
+                pending.push(i);
+        }
+        bool isAugmentable = false;
+        while(!pending.empty())  {
+            int i = pending.front();
+            pending.pop();
+            for(int j: meets[i])  {
+                int k = matchOfVertical[j];
+                if(k<0)
+                    isAugmentable = true;
+                else if(layer[k]<0)  {
+                    layer[k] = layer[i]+1;
+                    pending.push(k);
+                }
+            }
+        }
+        return isAugmentable;
+    };
+    function<bool(int)> augment = [&](int i)  {
+        for(; nextMeet[i]<meets[i].size(); nextMeet[i]++)  {
+            int j = meets[i][nextMeet[i]], k = matchOfVertical[j];
+            if(k<0 || (layer[k]==layer[i]+1 && augment(k)))  {
+                matchOfHorizontal[i] = j;
+                matchOfVertical[j] = i;
+                nextMeet[i]++;
+                return true;
+            }
+        }
+        //no path through i this round
+        layer[i] = -1;
+        return false;
+    };
+    while(layerChords())  {
+        fill(nextMeet.begin(), nextMeet.end(), 0);
+        for(int i = 0; i<h; i++)
+            if(matchOfHorizontal[i]<0)
+                augment(i);
+    }
+
+    //Koenig: from the unmatched horizontal chords follow unmatched then matched edges, the reached horizontal chords and
+    //the unreached vertical ones form a largest independent set
+    vector<bool> isReachedHorizontal(h, false), isReachedVertical(v, false);
+    vector<int> stack;
+    for(int i = 0; i<h; i++)
+        if(matchOfHorizontal[i]<0)  {
+            isReachedHorizontal[i] = true;
+            stack.push_back(i);
+        }
+    while(!stack.empty())  {
+        int i = stack.back();
+        stack.pop_back();
+        for(int j: meets[i])  {
+            if(isReachedVertical[j])
+                continue;
+            isReachedVertical[j] = true;
+            if(matchOfVertical[j]>=0 && !isReachedHorizontal[matchOfVertical[j]])  {
+                isReachedHorizontal[matchOfVertical[j]] = true;
+                stack.push_back(matchOfVertical[j]);
+            }
+        }
+    }
+    isChosenHorizontal = isReachedHorizontal;
+    isChosenVertical.assign(v, false);
+    for(int j = 0; j<v; j++)
+        isChosenVertical[j] = !isReachedVertical[j];
+}
+
+/**
+ * @brief Partitions a rectilinear polygon into the fewest rectangles
+ * @brief O(n log n + k sqrt(g)) time where n is the number of vertices, g the number of good chords and k the number of
+ * pairs of them that meet (at most g^2/4), O(n + k) space
+ * @param vertices vertices of the polygon in clockwise order, left untouched
+ * @param steinerCount set to the number of vertices added where cuts end inside edges
+ * @return Pointer to a new DCEL of clockwise rectangular faces numbered from 1, the original vertices keep their ids and the
+ * new ones are named s1, s2, ... (skipping ids already used); NULL if the polygon is not rectilinear
+ */
+template <class C>
+DCEL<C>* decomposeRectilinear(vector<Vertex<C>*> &vertices, int &steinerCount)  {
+    int n = vertices.size();
+    steinerCount = 0;
+    if(n<4)
+        return NULL;
+    vector<pair<C,C>> ring;
+    for(auto vertex: vertices)
+        ring.push_back(vertex->getCoordinate());
+    for(int i = 0; i<n; i++)  {
+        pair<C,C> a = ring[i], b = ring[(i+1)%n];
+        if(a==b || (a.first!=b.first && a.second!=b.second))
+            return NULL;
+    }
+
+    //notches and the direction their horizontal and vertical edges run into them
+    vector<bool> isNotch(n, false);
+    vector<int> directionX(n, 0), directionY(n, 0);
+    map<pair<C,C>, int> vertexAt;
+    for(int i = 0; i<n; i++)  {
+        pair<C,C> previous = ring[(i+n-1)%n], current = ring[i], next = ring[(i+1)%n];
+        vertexAt[current] = i;
+        double x1 = (double)previous.first-current.first, y1 = (double)previous.second-current.second;
+        double x2 = (double)next.first-current.first, y2 = (double)next.second-current.second;
+        if(x1*y2-x2*y1>=0)
+            continue;
+        isNotch[i] = true;
+        pair<C,C> alongX = previous.second==current.second ? previous : next;
+        pair<C,C> alongY = previous.first==current.first ? previous : next;
+        directionX[i] = current.first>alongX.first ? 1 : -1;
+        directionY[i] = current.second>alongY.second ? 1 : -1;
+    }
+
+    //the boundary edges standing across horizontal rays and across vertical rays (coordinates swapped)
+    vector<array<C,3>> verticalEdges, horizontalEdges;
+    for(int i = 0; i<n; i++)  {
+        pair<C,C> a = ring[i], b = ring[(i+1)%n];
+        if(a.first==b.first)
+            verticalEdges.push_back({a.first, min(a.second, b.second), max(a.second, b.second)});
+        else
+            horizontalEdges.push_back({a.second, min(a.first, b.first), max(a.first, b.first)});
+    }
+    vector<int> notches;
+    vector<array<C,3>> raysX, raysY;
+    for(int i = 0; i<n; i++)
+        if(isNotch[i])  {
+            notches.push_back(i);
+            raysX.push_back({ring[i].first, ring[i].second, (C)directionX[i]});
+            raysY.push_back({ring[i].second, ring[i].first, (C)directionY[i]});
+        }
+
+    //a notch's extension ending exactly on another notch is a good chord
+    vector<pair<C,int>> hitsX = shootRays(verticalEdges, raysX), hitsY = shootRays(horizontalEdges, raysY);
+    set<pair<int,int>> goodX, goodY;
+    for(int k = 0; k<notches.size(); k++)  {
+        int i = notches[k];
+        auto endX = vertexAt.find({hitsX[k].first, ring[i].second});
+        if(hitsX[k].second>=0 && endX!=vertexAt.end() && isNotch[endX->second])
+            goodX.insert({min(i, endX->second), max(i, endX->second)});
+        auto endY = vertexAt.find({ring[i].first, hitsY[k].first});
+        if(hitsY[k].second>=0 && endY!=vertexAt.end() && isNotch[endY->second])
+            goodY.insert({min(i, endY->second), max(i, endY->second)});
+    }
+    vector<pair<int,int>> chordsX(goodX.begin(), goodX.end()), chordsY(goodY.begin(), goodY.end());
+    vector<array<C,3>> horizontal, vertical;
+    for(auto &chord: chordsX)
+        horizontal.push_back({ring[chord.first].second, min(ring[chord.first].first, ring[chord.second].first), max(ring[chord.first].first, ring[chord.second].first)});
+    for(auto &chord: chordsY)
+        vertical.push_back({ring[chord.first].first, min(ring[chord.first].second, ring[chord.second].second), max(ring[chord.first].second, ring[chord.second].second)});
+    vector<bool> isChosenX, isChosenY;
+    largestDisjointChords(horizontal, vertical, isChosenX, isChosenY);
+
+    //cuts: the chosen chords, then the horizontal extension of every notch they leave
+    vector<pair<pair<C,C>,pair<C,C>>> cuts;
+    vector<bool> isCut(n, false);
+    vector<array<C,3>> stops = verticalEdges;
+    for(int c = 0; c<chordsX.size(); c++)
+        if(isChosenX[c])  {
+            cuts.push_back({ring[chordsX[c].first], ring[chordsX[c].second]});
+            isCut[chordsX[c].first] = isCut[chordsX[c].second] = true;
+        }
+    for(int c = 0; c<chordsY.size(); c++)
+        if(isChosenY[c])  {
+            cuts.push_back({ring[chordsY[c].first], ring[chordsY[c].second]});
+            isCut[chordsY[c].first] = isCut[chordsY[c].second] = true;
+            stops.push_back(vertical[c]);
+        }
+    vector<int> uncut;
+    vector<array<C,3>> extensions;
+    for(int k = 0; k<notches.size(); k++)
+        if(!isCut[notches[k]])  {
+            uncut.push_back(notches[k]);
+            extensions.push_back(raysX[k]);
+        }
+    vector<pair<C,int>> hitsExtension = shootRays(stops, extensions);
+    for(int k = 0; k<uncut.size(); k++)  {
+        if(hitsExtension[k].second<0)
+            return NULL;
+        cuts.push_back({ring[uncut[k]], {hitsExtension[k].first, ring[uncut[k]].second}});
+    }
+
+    //every segment end is a vertex, the originals first
+    vector<pair<C,C>> points = ring;
+    map<pair<C,C>, int> pointIndex = vertexAt;
+    for(auto &cut: cuts)
+        for(auto &end: {cut.first, cut.second})
+            if(!pointIndex.count(end))  {
+                pointIndex[end] = points.size();
+                points.push_back(end);
+            }
+    //points by row and by column, to split every segment at the points lying on it
+    map<C, vector<C>> rows, columns;
+    for(auto &point: points)  {
+        rows[point.second].push_back(point.first);
+        columns[point.first].push_back(point.second);
+    }
+    for(auto &row: rows)
+        sort(row.second.begin(), row.second.end());
+    for(auto &column: columns)
+        sort(column.second.begin(), column.second.end());
+    set<pair<int,int>> links;
+    vector<pair<pair<C,C>,pair<C,C>>> segments = cuts;
+    for(int i = 0; i<n; i++)
+        segments.push_back({ring[i], ring[(i+1)%n]});
+    for(auto &segment: segments)  {
+        pair<C,C> a = min(segment.first, segment.second), b = max(segment.first, segment.second);
+        bool isHorizontal = a.second==b.second;
+        vector<C> &positions = isHorizontal ? rows[a.second] : columns[a.first];
+        C from = isHorizontal ? a.first : a.second, to = isHorizontal ? b.first : b.second;
+        int last = pointIndex[a];
+        for(auto it = upper_bound(positions.begin(), positions.end(), from); it!=positions.end() && *it<=to; it++)  {
+            int current = pointIndex[isHorizontal ? make_pair(*it, a.second) : make_pair(a.first, *it)];
+            links.insert({min(last, current), max(last, current)});
+            last = current;
+        }
+    }
+
+    //half-edges leaving every point to the east, north, west and south
+    int m = points.size();
+    vector<array<int,4>> leaving(m, {-1, -1, -1, -1});
+    vector<pair<int,int>> halfEdges;
+    auto heading = [&](int from, int to)  {
+        pair<C,C> a = points[from], b = points[to];
+        return b.first>a.first ? 0 : (b.second>a.second ? 1 : (b.first<a.first ? 2 : 3));
+    };
+    for(auto &link: links)
+        for(auto &half: {link, make_pair(link.second, link.first)})  {
+            leaving[half.first][heading(half.first, half.second)] = halfEdges.size();
+            halfEdges.push_back(half);
+        }
+
+    //walk the faces keeping them on the right: turn right if possible, else go straight, else turn left
+    vector<int> faceOf(halfEdges.size(), -1);
+    vector<vector<int>> cycles;
+    for(int e = 0; e<halfEdges.size(); e++)  {
+        if(faceOf[e]>=0)
+            continue;
+        vector<int> cycle;
+        int current = e;
+        do  {
+            faceOf[current] = cycles.size();
+            cycle.push_back(current);
+            int to = halfEdges[current].second, direction = heading(halfEdges[current].first, to), next = -1;
+            for(int turn: {3, 0, 1, 2})
+                if(next<0)
+                    next = leaving[to][(direction+turn)%4];
+            current = next;
+        }while(current!=e);
+        cycles.push_back(cycle);
+    }
+
+    unordered_set<string> usedIds;
+    for(auto vertex: vertices)
+        usedIds.insert(vertex->getId());
+    vector<Vertex<C>*> newVertices;
+    int nextId = 1;
+    for(int p = 0; p<m; p++)  {
+        string id;
+        if(p<n)
+            id = vertices[p]->getId();
+        else  {
+            do
+                id = "s"+to_string(nextId++);
+            while(usedIds.count(id));
+        }
+        newVertices.push_back(new Vertex<C>(id, points[p]));
+    }
+    steinerCount = m-n;
+
+    //the clockwise cycles are the rectangles, the single anticlockwise one runs around the outside
+    vector<Edge<C>*> edgeOf(halfEdges.size(), NULL), newEdges;
+    vector<Face<C>*> newFaces;
+    for(auto &cycle: cycles)  {
+        double area = 0;
+        for(int e: cycle)  {
+            pair<C,C> a = points[halfEdges[e].first], b = points[halfEdges[e].second];
+            area += (double)a.first*b.second-(double)b.first*a.second;
+        }
+        if(area>=0)
+            continue;
+        Face<C>* face = new Face<C>(newFaces.size()+1, NULL);
+        for(int e: cycle)  {
+            edgeOf[e] = new Edge<C>(newVertices[halfEdges[e].first]);
+            edgeOf[e]->setLeftFace(face);
+            newVertices[halfEdges[e].first]->setIncidentEdge(edgeOf[e]);
+            newEdges.push_back(edgeOf[e]);
+        }
+        for(int k = 0; k<cycle.size(); k++)  {
+            edgeOf[cycle[k]]->setNextEdge(edgeOf[cycle[(k+1)%cycle.size()]]);
+            edgeOf[cycle[(k+1)%cycle.size()]]->setPrevEdge(edgeOf[cycle[k]]);
+        }
+        face->setIncidentEdge(edgeOf[cycle[0]]);
+        newFaces.push_back(face);
+    }
+    //the two halves of a link are stored next to each other
+    for(int e = 0; e<halfEdges.size(); e += 2)
+        if(edgeOf[e] && edgeOf[e+1])  {
+            edgeOf[e]->setTwinEdge(edgeOf[e+1]);
+            edgeOf[e+1]->setTwinEdge(edgeOf[e]);
+        }
+    return new DCEL<C>(newVertices, newEdges, newFaces);
+}
+
+#endif
@@ -0,0 +1,226 @@
+/*
+Header File traceEvents.h
+usage- #include "traceEvents.h"
+
+Optional timeline of a run in the Chrome trace-event JSON format, which chrome://tracing and ui.perfetto.dev open
+directly. A TraceSpan marks one phase from its construction to the end of its scope and becomes a complete ("X")
+event on the track of the thread that ran it, with up to three numeric arguments (the start offset, the restarts of
+a partition, ...). Every thread appends to its own buffer, so recording takes no lock; the buffers are written out
+once the work is done. While tracing is off a span only reads one flag.
+*/
+
+/**
+
+*@file traceEvents.h
+*@brief Span based tracing with per-thread tracks, written as Chrome trace-event / Perfetto JSON.
+
+*/
+
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+/**
+ * @brief Most arguments a span carries
+ */
+#define TRACE_MAX_ARGUMENTS 3
+
+/**
+ * @struct TraceEvent
+ * @brief A finished span, times in nanoseconds since tracing started; names and keys are string literals
+ */
+struct TraceEvent  {
+    const char* name;
+    long long start, duration;
+    int argumentCount;
+    const char* keys[TRACE_MAX_ARGUMENTS];
+    long long values[TRACE_MAX_ARGUMENTS];
+};
+
+/**
+ * @class TraceRecorder
+ * @brief Collects the spans of every thread, one track per thread
+ *
+ * Usage-
+ *     traceRecorder.start();
+ *     traceRecorder.nameThread("worker 1");       // optional, from the thread itself
+ *     { TraceSpan span("partition"); ... }
+ *     traceRecorder.write("trace.json");          // after every traced thread is done
+ */
+class TraceRecorder  {
+private:
+    struct Track  {
+        int id;
+        string name;
+        vector<TraceEvent> events;
+    };
+    bool enabled = false;
+    chrono::steady_clock::time_point origin;
+    mutex tracksLock;
+    vector<unique_ptr<Track>> tracks;
+
+    //the track of the calling thread, registered the first time the thread records anything
+    Track* currentTrack()  {
+        thread_local Track* track = NULL;
+        if(!track)  {
+            lock_guard<mutex> lock(tracksLock);
+            tracks.push_back(unique_ptr<Track>(new Track{(int)tracks.size()+1, "thread "+to_string(tracks.size()+1), {}}));
+            track = tracks.back().get();
+        }
+        return track;
+    }
+
+    static void writeString(ostream &out, const string &text)  {
+        out<<'"';
+        for(char c: text)  {
+            if(c=='"' || c=='\\')
+                out<<'\\'<<c;
+            else if((unsigned char)c<0x20)
+                out<<' ';
+            else
+                out<<c;
+        }
+        out<<'"';
+    }
+
+public:
+    /**
+     * @brief Turns tracing on, time 0 of the trace is now; call before any traced thread starts
+     */
+    void start()  {
+        origin = chrono::steady_clock::now();
+        enabled = true;
+    }
+
+    bool isEnabled() const  {
+        return enabled;
+    }
+
+    /**
+     * @brief Nanoseconds since start
+     */
+    long long now() const  {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now()-origin).count();
+    }
+
+    /**
+     * @brief Names the track of the calling thread
+     */
+    void nameThread(const string &name)  {
+        if(enabled)
+            currentTrack()->name = name;
+    }
+
+    /**
+     * @brief Appends a finished span to the track of the calling thread
+     */
+    void record(const TraceEvent &event)  {
+        currentTrack()->events.push_back(event);
+    }
+
+    /**
+     * @brief Writes every track as a Chrome trace-event JSON object
+     * @brief O(e) time where e is the number of spans
+     * @return false if the file could not be opened
+     */
+    bool write(const string &fileName)  {
+        ofstream out(fileName);
+        if(!out)
+            return false;
+        out<<"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out<<"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"polygonDecomposition\"}}";
+        out<<fixed<<setprecision(3);
+        lock_guard<mutex> lock(tracksLock);
+        for(auto &track: tracks)  {
+            out<<",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"<<track->id<<",\"args\":{\"name\":";
+            writeString(out, track->name);
+            out<<"}}";
+            for(TraceEvent &event: track->events)  {
+                out<<",\n{\"name\":";
+                writeString(out, event.name);
+                out<<",\"ph\":\"X\",\"pid\":1,\"tid\":"<<track->id<<",\"ts\":"<<event.start/1000.0<<",\"dur\":"<<event.duration/1000.0;
+                if(event.argumentCount)  {
+                    out<<",\"args\":{";
+                    for(int i = 0; i<event.argumentCount; i++)  {
+                        out<<(i ? "," : "");
+                        writeString(out, event.keys[i]);
+                        out<<":"<<event.values[i];
+                    }
+                    out<<"}";
+                }
+                out<<"}";
+            }
+        }
+        out<<"\n]}\n";
+        return true;
+    }
+};
+
+/**
+ * @brief The recorder every span reports to
+ */
+inline TraceRecorder traceRecorder;
+
+/**
+ * @class TraceSpan
+ * @brief Times the enclosing scope as one span of the calling thread
+ */
+class TraceSpan  {
+private:
+    TraceEvent event;
+    bool isRecording;
+
+public:
+    /**
+     * @param name string literal shown on the span
+     */
+    TraceSpan(const char* name)  {
+        isRecording = traceRecorder.isEnabled();
+        if(isRecording)  {
+            event.name = name;
+            event.argumentCount = 0;
+            event.start = traceRecorder.now();
+        }
+    }
+
+    TraceSpan(const char* name, const char* key, long long value) : TraceSpan(name)  {
+        setArgument(key, value);
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    /**
+     * @brief Attaches a value shown with the span, setting a key again overwrites it
+     * @param key string literal
+     */
+    void setArgument(const char* key, long long value)  {
+        if(!isRecording)
+            return;
+        for(int i = 0; i<event.argumentCount; i++)
+            if(!strcmp(event.keys[i], key))  {
+                event.values[i] = value;
+                return;
+            }
+        if(event.argumentCount<TRACE_MAX_ARGUMENTS)  {
+            event.keys[event.argumentCount] = key;
+            event.values[event.argumentCount++] = value;
+        }
+    }
+
+    /**
+     * @brief Ends the span before the end of its scope
+     */
+    void end()  {
+        if(isRecording)  {
+            event.duration = traceRecorder.now()-event.start;
+            traceRecorder.record(event);
+            isRecording = false;
+        }
+    }
+
+    ~TraceSpan()  {
+        end();
+    }
+};
+
+#endif
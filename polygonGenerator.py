@@ -63,7 +63,7 @@ for num_points in range(3, 102):
         letter="id"
         id = 1
         for each in points_sorted:
-             f.write(letter+str(id)+' '+'{:.2f}'.format(round(each[0], 2))+' '+'{:.2f}\n'.format(round(each[0], 2)))
+             f.write(letter+str(id)+' '+'{:.2f}'.format(round(each[0], 2))+' '+'{:.2f}\n'.format(round(each[1], 2)))
              id += 1
 
 
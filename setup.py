@@ -0,0 +1,25 @@
+# Builds the polygon_decomposition Python module from polygonDecomposition/pythonBindings.cpp against pybind11
+#
+# usage- pip install pybind11 numpy
+#        python3 setup.py build_ext --inplace
+#        python3 test_pythonBindings.py
+
+from setuptools import setup
+from pybind11.setup_helpers import Pybind11Extension, build_ext
+
+setup(
+    name="polygon_decomposition",
+    version="1.0",
+    description="Decomposition of simple polygons into few convex pieces",
+    ext_modules=[
+        Pybind11Extension(
+            "polygon_decomposition",
+            ["polygonDecomposition/pythonBindings.cpp"],
+            cxx_std=17,
+            extra_compile_args=["-O3", "-pthread"],
+            extra_link_args=["-pthread"],
+        )
+    ],
+    cmdclass={"build_ext": build_ext},
+    zip_safe=False,
+)
@@ -0,0 +1,47 @@
+# Smoke test of the polygon_decomposition module, built in place with setup.py
+#
+# usage- python3 test_pythonBindings.py    (or pytest test_pythonBindings.py)
+
+import numpy as np
+import polygon_decomposition as pd
+
+# L shaped ring of area 3 in clockwise order, one notch at (1, 1)
+ring = np.array([[0, 0], [0, 2], [2, 2], [2, 1], [1, 1], [1, 0]], dtype=np.float32)
+
+
+def signed_area(points):
+    x, y = points[:, 0].astype(np.float64), points[:, 1].astype(np.float64)
+    return (np.dot(x, np.roll(y, -1)) - np.dot(np.roll(x, -1), y)) / 2
+
+
+def check_decomposition(points, rectangles):
+    indices, offsets, steiner = pd.decompose(points, rectangles)
+    # rows n, n+1, ... of the vertex table are the steiner points
+    table = np.vstack([points, steiner.reshape(-1, 2)])
+    assert len(offsets) - 1 == 2
+    total = 0
+    for f in range(len(offsets) - 1):
+        face = table[indices[offsets[f]:offsets[f + 1]]]
+        # faces come back clockwise, so with a negative signed area
+        assert signed_area(face) < 0
+        total -= signed_area(face)
+    assert abs(total - 3) < 1e-6
+
+
+def test_rectangles():
+    check_decomposition(ring, True)
+
+
+def test_convex_pieces():
+    check_decomposition(ring, False)
+
+
+def test_anticlockwise_ring():
+    check_decomposition(ring[::-1].copy(), True)
+
+
+if __name__ == "__main__":
+    test_rectangles()
+    test_convex_pieces()
+    test_anticlockwise_ring()
+    print("ok")